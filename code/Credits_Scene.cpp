@@ -3,6 +3,7 @@
  * Copyright © 2020+ Mariana Moreira
  */
 
+#include <basics/Asset_Cache>
 #include <basics/Canvas>
 #include <basics/Director>
 #include <basics/Transformation>
@@ -85,11 +86,13 @@ namespace flip
 
                 canvas_width = unsigned(canvas_height * real_aspect_ratio);
 
-                credits_texture = Texture_2D::create (ID(credits_texture), context, credits_path);        // Loads the credits texture
-                button_texture  = Texture_2D::create (ID(button_texture),  context, button_path);         // Loads the button texture
+                Texture_2D::Options credits_options;
 
-                context->add(credits_texture);
-                context->add(button_texture);
+                credits_options.format = Texture_2D::RGB565;
+                credits_options.dither = true;
+
+                credits_texture = Asset_Cache::get_instance ().get_texture (context, credits_path, credits_options);    // Loads the credits texture
+                button_texture  = Asset_Cache::get_instance ().get_texture (context, button_path);         // Loads the button texture
 
                 // button sprite
                 home_button.reset(new Sprite(button_texture.get()));
@@ -34,6 +34,50 @@ namespace flip
     // ----------------------------------------------------------------------------------------------------------------------------------------------------------------
 
     void Food::render(Canvas & canvas)
+    {
+        Sprite_Instance instance;
+
+        if (get_sprite_instance (instance))
+        {
+            /*
+            // Draws the collider
+            canvas.set_color (0.f, 1.f, 0.f);
+            canvas.draw_rectangle({ position[0] - radius, position[1] - radius }, { radius * 2.f, radius * 2.f });
+             */
+
+            // Draws the food element
+            canvas.fill_rectangle (instance.position, instance.size, instance.slice, instance.handling);
+        }
+    }
+
+
+    // ----------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+    bool Food::get_sprite_instance (Sprite_Instance & instance)
+    {
+        const Atlas::Slice * animation_slice = get_animation_slice ();
+
+        if (animation_slice)
+        {
+            size[0] = animation_slice->width;
+            size[1] = animation_slice->height;
+
+            instance.slice    = animation_slice;
+            instance.position = position;
+            instance.size     = size;
+            instance.opacity  = 1.f;
+            instance.handling = Anchor::CENTER;
+
+            return true;
+        }
+
+        return false;
+    }
+
+
+    // ----------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+    const Atlas::Slice * Food::get_animation_slice () const
     {
         // The appropriate frame is searched depending on the number of frames available for the animation of ascending or falling and of the speed at which the food is moving
         const Atlas::Slice * animation_slice = nullptr;     // It is not yet known which frame it will be
@@ -71,26 +115,7 @@ namespace flip
             }
         }
 
-        if (animation_slice)
-        {
-            size[0] = animation_slice->width;
-            size[1] = animation_slice->height;
-
-            /*
-            // Draws the collider
-            canvas.set_color (0.f, 1.f, 0.f);
-            canvas.draw_rectangle({ position[0] - radius, position[1] - radius }, { radius * 2.f, radius * 2.f });
-             */
-
-            // Draws the food element
-            canvas.fill_rectangle
-            (
-                  position,
-                { animation_slice->width, animation_slice->height },
-                  animation_slice,
-                  Anchor::CENTER
-            );
-        }
+        return animation_slice;
     }
 
 
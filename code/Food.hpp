@@ -158,11 +158,26 @@ namespace flip
          */
 		void render (Canvas & canvas);
 
+		/**
+         * This method fills the data needed to draw the food element together with others in a single call
+         * @param instance Sprite instance that will receive the current frame, position and size
+         * @return true if there is a frame to draw or false otherwise
+         */
+		bool get_sprite_instance (Sprite_Instance & instance);
+
 		/**
          * This method checks if the food element contains the given point
          * @param point Point that will be used to determine if a food element was clicked
          */
 		bool contains_point (const Point2f & point);
 
+	private:
+
+		/**
+         * This method looks for the animation frame that matches the current speed
+         * @return the slice of the frame or nullptr if there is none
+         */
+		const Atlas::Slice * get_animation_slice () const;
+
 	};
 }
@@ -4,13 +4,13 @@
  */
 
 #include <basics/Log>
+#include <basics/Asset_Cache>
+#include <basics/Asset_Loader>
 #include <basics/Canvas>
 #include <basics/Director>
 
 #include <cmath>
 #include <cstdlib>
-#include <iomanip>
-#include <sstream>
 
 #include "Game_Scene.hpp"
 #include "Pause_Scene.hpp"
@@ -50,6 +50,7 @@ namespace flip
     bool Game_Scene::initialize ()
     {
         state = LOADING;
+        loading = shared_future< bool > ();
         //state             = background.get () ? RUNNING : LOADING;
 
         gameplay          = UNINITIALIZED;
@@ -146,15 +147,30 @@ namespace flip
 
                 if (state == RUNNING || state == PREPARE)
                 {
+                    // Draws are queued and sorted by layer and texture until sorting is disabled
+                    canvas->set_sorting (true);
+
                     // Draws the background image
+                    canvas->set_layer (0);
                     canvas->fill_rectangle ({ 0.f, 0.f }, { canvas_width, canvas_height }, background.get (), Anchor::BOTTOM | Anchor::LEFT);
 
-                    // Draws the food elements
+                    // Draws the food elements with a single call
+                    food_instances.clear ();
+
                     for (auto & item : food)
                     {
-                        item->render (*canvas);
+                        Sprite_Instance instance;
+
+                        if (item->get_sprite_instance (instance))
+                        {
+                            food_instances.push_back (instance);
+                        }
                     }
 
+                    canvas->set_layer (1);
+                    canvas->draw_sprites (food_instances);
+
+                    canvas->set_layer (2);
 
                     if (state == PREPARE)
                     {
@@ -166,27 +182,18 @@ namespace flip
                         score_icon  ->render (*canvas);                          // Draws the score icon
                         pause_button->render (*canvas);                          // Draws the pause button
 
-                        wostringstream buffer_lifes;
-                        wostringstream buffer_score;
-                        wostringstream buffer_timer;
-
-                        buffer_lifes << setfill (L'0');
-                        buffer_lifes << lives_counter;
-
-                        buffer_score << setfill (L'0');
-                        buffer_score << score_counter;
-
-                        buffer_timer << setfill (L'0');
-                        buffer_timer << floor(game_timer.get_elapsed_seconds());
-
-                        Text_Layout lives_text(*lives_font, buffer_lifes.str ());
-                        Text_Layout score_text(*score_font, buffer_score.str ());
-                        Text_Layout timer_text(*timer_font, buffer_timer.str ());
+                        // The layouts are only rebuilt when the displayed values change
+                        lives_text.assign_number (*lives_font, lives_counter);
+                        score_text.assign_number (*score_font, score_counter);
+                        timer_text.assign_number (*timer_font, int(floor(game_timer.get_elapsed_seconds())));
 
                         canvas->draw_text ({ life_icon->get_width(), canvas_height - 50.f }, lives_text, CENTER);                                       // Writes the lives counter
                         canvas->draw_text ({ score_icon->get_width() + life_icon->get_width() + 60.f , canvas_height - 50.f }, score_text, LEFT);       // Writes the score counter
                         canvas->draw_text ({ canvas_width / 2.f, canvas_height - 50.f }, timer_text, CENTER);                                           // Writes the game timer
                     }
+
+                    // Submits the sorted draws (the canvas is shared with the other scenes)
+                    canvas->set_sorting (false);
                 }
 
                 if (gameplay == GAMEOVER)
@@ -204,6 +211,28 @@ namespace flip
 
     void Game_Scene::load_textures ()
     {
+        // The files are read and decoded by the asset loader threads, so only the textures are created here.
+        // Those still resident in the asset cache from a previous game are not read again
+        if (!loading.valid ())
+        {
+            loading = Asset_Loader::get_instance ().load (Asset_Cache::get_instance ().missing ({ background_path, prepare_path, sprites_atlas_path, font_path }));
+        }
+
+        if (loading.wait_for (chrono::seconds(0)) != future_status::ready) return;
+
+        // The background is uploaded to the GPU in strips over several frames, so the game waits until it is complete
+        if (background)
+        {
+            if (background->is_ready ())
+            {
+                state = PREPARE;
+
+                game_timer.reset();
+            }
+
+            return;
+        }
+
         Graphics_Context::Accessor context = director.lock_graphics_context ();
 
         if (context)
@@ -213,15 +242,17 @@ namespace flip
 
             canvas_width = unsigned(canvas_height * real_aspect_ratio);
 
-            background      = Texture_2D::create (ID(background),      context, background_path);         // Loads the background texture
-            prepare_texture = Texture_2D::create (ID(prepare_texture), context, prepare_path);            // Loads the get ready texture
+            Asset_Cache & cache = Asset_Cache::get_instance ();
 
-            // Checks if the texture was loaded correctly
-            if (background) {
-                context->add (background);
-                context->add (prepare_texture);
-            }
-            else
+            Texture_2D::Options background_options;
+
+            background_options.staged = true;
+
+            background      = cache.get_texture (context, background_path, background_options);  // Loads the background texture in strips
+            prepare_texture = cache.get_texture (context, prepare_path);            // Loads the get ready texture
+
+            // Checks if the textures were loaded correctly
+            if (!background || !prepare_texture)
             {
                 state = ERROR;
                 return;
@@ -232,9 +263,9 @@ namespace flip
             prepare->set_position ({ canvas_width / 2, canvas_height / 2 });
 
             // Loads the sprite atlas
-            sprites_atlas.reset (new Atlas(sprites_atlas_path, context));
+            sprites_atlas = cache.get_atlas (context, sprites_atlas_path);
 
-            if (!sprites_atlas->good ()) { state = ERROR; return; }
+            if (!sprites_atlas) { state = ERROR; return; }
 
             // Loads the life icon
             life_icon.reset(new Sprite(sprites_atlas->get_slice (ID(life))));
@@ -248,18 +279,15 @@ namespace flip
             pause_button.reset(new Sprite(sprites_atlas->get_slice (ID(pause))));
             pause_button->set_position({ canvas_width - 50.f, canvas_height - 50.f });
 
-            // Creates the lives counter
-            lives_font.reset (new Raster_Font(font_path, context));
-
-            // Creates the score counter
-            score_font.reset (new Raster_Font(font_path, context));
-
-            // Creates the game timer
-            timer_font.reset (new Raster_Font(font_path, context));
+            // The lives counter, the score counter and the game timer share the same cached font
+            lives_font = cache.get_font (context, font_path);
+            score_font = lives_font;
+            timer_font = lives_font;
 
-            state = PREPARE;
+            if (!lives_font) { state = ERROR; return; }
 
-            game_timer.reset();
+            // The decoded images are no longer needed once the textures exist
+            Asset_Loader::get_instance ().clear ();
         }
     }
 
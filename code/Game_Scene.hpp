@@ -8,11 +8,13 @@
 
     #include <map>
     #include <list>
+    #include <future>
     #include <memory>
 
     #include <basics/Canvas>
     #include <basics/Id>
     #include <basics/Scene>
+    #include <basics/Text_Layout>
     #include <basics/Texture_2D>
     #include <basics/Timer>
 
@@ -89,6 +91,7 @@
             int            limit_pancakes    = 0;                   ///< Limit of pancakes that need be launched for a strawberry to appear
 
             vector< std::shared_ptr< Food > > food;                 ///< Array with all the food elements
+            vector< Sprite_Instance >      food_instances;          ///< Sprite instances used to draw all the food elements at once
 
             shared_ptr< Texture_2D >  background;                   ///< Texture with the background image
             shared_ptr< Texture_2D >  prepare_texture;              ///< Texture with the get ready image
@@ -98,11 +101,17 @@
             shared_ptr< Sprite >      score_icon;                   ///< Score sprite
             shared_ptr< Sprite >      pause_button;                 ///< Pause button sprite
 
-            unique_ptr< Atlas >       sprites_atlas;                ///< Atlas that contains the images of all the game sprites
+            shared_ptr< Atlas >       sprites_atlas;                ///< Atlas that contains the images of all the game sprites
 
-            unique_ptr< Raster_Font > lives_font;                   ///< Font to drawn the player lives
-            unique_ptr< Raster_Font > score_font;                   ///< Font to drawn the game score
-            unique_ptr< Raster_Font > timer_font;                   ///< Font to drawn the game timer
+            shared_ptr< Raster_Font > lives_font;                   ///< Font to drawn the player lives
+            shared_ptr< Raster_Font > score_font;                   ///< Font to drawn the game score
+            shared_ptr< Raster_Font > timer_font;                   ///< Font to drawn the game timer
+
+            Text_Layout               lives_text;                   ///< Layout of the lives counter, kept between frames
+            Text_Layout               score_text;                   ///< Layout of the score counter, kept between frames
+            Text_Layout               timer_text;                   ///< Layout of the game timer, kept between frames
+
+            shared_future< bool >     loading;                      ///< Completes when the scene files have been read and decoded
 
             Timer       game_timer;                                 ///< Timer used to measure the time in game
             Timer       spawn_timer;                                ///< Timer used to measure the time between food items being spwaned
@@ -169,7 +178,7 @@
         private:
 
             /**
-             * This method loads the textures (one each frame to facilitate, so that the load itself can be paused when the application goes to the background)
+             * This method starts reading and decoding the scene files in the background and, once they are ready, creates the textures (the scene keeps running frames while it waits)
              */
             void load_textures ();
 
@@ -3,13 +3,12 @@
  * Copyright © 2020+ Mariana Moreira
  */
 
+#include <basics/Asset_Cache>
+#include <basics/Asset_Loader>
 #include <basics/Canvas>
 #include <basics/Director>
 #include <basics/Transformation>
 
-#include <iomanip>
-#include <sstream>
-
 #include "Gameover_Scene.hpp"
 #include "Game_Scene.hpp"
 #include "Menu_Scene.hpp"
@@ -115,6 +114,15 @@ namespace flip
     {
         if (!suspended) if (state == LOADING)
         {
+            // The files are read and decoded by the asset loader threads, so only the textures are created here.
+            // Those still resident in the asset cache are not read again
+            if (!loading.valid ())
+            {
+                loading = Asset_Loader::get_instance ().load (Asset_Cache::get_instance ().missing ({ gameover_path, button_path, buttons_atlas_path, text_atlas_path, font_path }));
+            }
+
+            if (loading.wait_for (chrono::seconds(0)) != future_status::ready) return;
+
             Graphics_Context::Accessor context = director.lock_graphics_context ();
 
             if (context)
@@ -124,22 +132,31 @@ namespace flip
 
                 canvas_width = unsigned(canvas_height * real_aspect_ratio);
 
-                // Loads the pause texture
-                gameover_texture = Texture_2D::create (ID(gameover_texture), context, gameover_path);      // Loads the gameover texture
-                button_texture   = Texture_2D::create (ID(button_texture),   context, button_path);        // Loads the button texture
+                Texture_2D::Options gameover_options;
+
+                gameover_options.format = Texture_2D::RGB565;
+                gameover_options.dither = true;
+
+                gameover_texture = Asset_Cache::get_instance ().get_texture (context, gameover_path, gameover_options);    // Loads the gameover texture
+                button_texture   = Asset_Cache::get_instance ().get_texture (context, button_path);        // Loads the button texture
 
-                context->add(gameover_texture);
-                context->add(button_texture);
+                if (!gameover_texture || !button_texture) { state = ERROR; return; }
 
                 // button sprite
                 home_button.reset(new Sprite(button_texture.get()));
                 home_button->set_position({ canvas_width - 50.f, canvas_height - 50.f });
 
-                // Loads the menu buttons atlas
-                button_atlas.reset (new Atlas(buttons_atlas_path, context));
+                // Loads the menu buttons atlas with mipmaps, as the pressed options are drawn minified, and
+                // premultiplied alpha so the minified edges do not darken
+                Texture_2D::Options atlas_options;
+
+                atlas_options.mipmaps       = true;
+                atlas_options.premultiplied = true;
+
+                button_atlas = Asset_Cache::get_instance ().get_atlas (context, buttons_atlas_path, atlas_options);
 
                 // If the atlas could be loaded then the state is READY if not the is ERROR
-                state = button_atlas->good () ? PREPARE : ERROR;
+                state = button_atlas ? PREPARE : ERROR;
 
                 // If the atlas is available, the menu option data is initialized
                 if (state == PREPARE)
@@ -147,7 +164,9 @@ namespace flip
                     configure_options ();
 
                     // Loads the menu buttons atlas
-                    text_atlas.reset (new Atlas(text_atlas_path, context));
+                    text_atlas = Asset_Cache::get_instance ().get_atlas (context, text_atlas_path);
+
+                    if (!text_atlas) { state = ERROR; return; }
 
                     // Loads the score icon
                     score_icon.reset(new Sprite(text_atlas->get_slice (ID(score))));
@@ -157,14 +176,17 @@ namespace flip
                     time_icon.reset(new Sprite(text_atlas->get_slice (ID(time))));
                     time_icon->set_position({ canvas_width / 2.f + 150.f, canvas_height / 2.f });
 
-                    // Creates the score counter
-                    score_font.reset (new Raster_Font(font_path, context));
+                    // The score and the game timer are drawn with the same cached font
+                    score_font = Asset_Cache::get_instance ().get_font (context, font_path);
+                    timer_font = score_font;
 
-                    // Creates the game timer
-                    timer_font.reset (new Raster_Font(font_path, context));
+                    if (!score_font) { state = ERROR; return; }
 
                     state = READY;
                 }
+
+                // The decoded images are no longer needed once the textures exist
+                Asset_Loader::get_instance ().clear ();
             }
         }
     }
@@ -218,17 +240,9 @@ namespace flip
                     score_icon ->render (*canvas);
                     time_icon  ->render (*canvas);
 
-                    wostringstream buffer_score;
-                    wostringstream buffer_timer;
-
-                    buffer_score << setfill (L'0');
-                    buffer_score << game_score;
-
-                    buffer_timer << setfill (L'0');
-                    buffer_timer << game_time;
-
-                    Text_Layout score_text(*score_font, buffer_score.str ());
-                    Text_Layout timer_text(*timer_font, buffer_timer.str ());
+                    // The layouts are only rebuilt when the displayed values change
+                    score_text.assign_number (*score_font, game_score);
+                    timer_text.assign_number (*timer_font, int(game_time));
 
                     canvas->draw_text ({ canvas_width / 2.f - 150.f, canvas_height / 2.f - 50.f }, score_text, CENTER);
                     canvas->draw_text ({ canvas_width / 2.f + 150.f, canvas_height / 2.f - 50.f }, timer_text, CENTER);
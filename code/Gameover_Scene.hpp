@@ -6,6 +6,7 @@
 #ifndef GAMEOVER_SCENE_HEADER
 #define GAMEOVER_SCENE_HEADER
 
+    #include <future>
     #include <memory>
 
     #include <basics/Atlas>
@@ -13,6 +14,7 @@
     #include <basics/Point>
     #include <basics/Scene>
     #include <basics/Size>
+    #include <basics/Text_Layout>
     #include <basics/Texture_2D>
 
     #include "Sprite.hpp"
@@ -84,15 +86,20 @@
             shared_ptr< Texture_2D >  gameover_texture;         ///< Texture with the gameover image
             shared_ptr< Texture_2D >  button_texture;           ///< Texture with the home button image
 
-            unique_ptr< Atlas >       button_atlas;             ///< Atlas with the menu options images
-            unique_ptr< Atlas >       text_atlas;               ///< Atlas with the gameover text
+            shared_ptr< Atlas >       button_atlas;             ///< Atlas with the menu options images
+            shared_ptr< Atlas >       text_atlas;               ///< Atlas with the gameover text
 
             shared_ptr< Sprite >      home_button;              ///< Home button sprite
             shared_ptr< Sprite >      score_icon;               ///< Score sprite
             shared_ptr< Sprite >      time_icon;                ///< Time sprite
 
-            unique_ptr< Raster_Font > score_font;               ///< Font to drawn the game score
-            unique_ptr< Raster_Font > timer_font;               ///< Font to drawn the game timer
+            shared_ptr< Raster_Font > score_font;               ///< Font to drawn the game score
+            shared_ptr< Raster_Font > timer_font;               ///< Font to drawn the game timer
+
+            Text_Layout               score_text;               ///< Layout of the final score, kept between frames
+            Text_Layout               timer_text;               ///< Layout of the final time, kept between frames
+
+            shared_future< bool >     loading;                  ///< Completes when the scene files have been read and decoded
 
             int game_score;                                     ///< Final game score
             int game_time;                                      ///< Final game time
@@ -3,6 +3,7 @@
  * Copyright © 2020+ Mariana Moreira
  */
 
+#include <basics/Asset_Cache>
 #include <basics/Canvas>
 #include <basics/Director>
 #include <basics/Transformation>
@@ -85,11 +86,13 @@ namespace flip
 
                 canvas_width = unsigned(canvas_height * real_aspect_ratio);
 
-                help_texture   = Texture_2D::create (ID(help_texture),   context, help_path);           // Loads the help texture
-                button_texture = Texture_2D::create (ID(button_texture), context, button_path);         // Loads the button texture
+                Texture_2D::Options help_options;
 
-                context->add(help_texture);
-                context->add(button_texture);
+                help_options.format = Texture_2D::RGB565;
+                help_options.dither = true;
+
+                help_texture   = Asset_Cache::get_instance ().get_texture (context, help_path, help_options);  // Loads the help texture
+                button_texture = Asset_Cache::get_instance ().get_texture (context, button_path);         // Loads the button texture
 
                 // button sprite
                 home_button.reset(new Sprite(button_texture.get()));
@@ -3,6 +3,8 @@
  * Copyright © 2020+ Mariana Moreira
  */
 
+#include <basics/Asset_Cache>
+#include <basics/Asset_Loader>
 #include <basics/Canvas>
 #include <basics/Director>
 #include <basics/Transformation>
@@ -110,6 +112,22 @@ namespace flip
     {
         if (!suspended) if (state == LOADING)
         {
+            // The files are read and decoded by the asset loader threads, so only the textures are created here.
+            // Those still resident in the asset cache from a previous visit are not read again
+            if (!loading.valid ())
+            {
+                loading = Asset_Loader::get_instance ().load (Asset_Cache::get_instance ().missing ({ background_path, buttons_atlas_path }));
+            }
+
+            if (loading.wait_for (chrono::seconds(0)) != future_status::ready) return;
+
+            // The background is uploaded to the GPU in strips over several frames, so the menu waits until it is complete
+            if (background_texture)
+            {
+                if (background_texture->is_ready ()) state = READY;
+                return;
+            }
+
             Graphics_Context::Accessor context = director.lock_graphics_context ();
 
             if (context)
@@ -119,22 +137,34 @@ namespace flip
 
                 canvas_width = unsigned(canvas_height * real_aspect_ratio);
 
-                // Loads the background texture
-                background_texture = Texture_2D::create (ID(background_texture), context, background_path);
+                // Loads the background texture, which is uploaded in strips so the transition has no long frame
+                Texture_2D::Options background_options;
 
-                context->add(background_texture);
+                background_options.staged = true;
 
-                // Loads the menu buttons atlas
-                button_atlas.reset (new Atlas(buttons_atlas_path, context));
+                background_texture = Asset_Cache::get_instance ().get_texture (context, background_path, background_options);
 
-                // If the atlas could be loaded then the state is READY if not the is ERROR
-                state = button_atlas->good () ? READY : ERROR;
+                if (!background_texture) { state = ERROR; return; }
 
-                // If the atlas is available, the menu option data is initialized
-                if (state == READY)
+                // Loads the menu buttons atlas with mipmaps, as the pressed options are drawn minified, and
+                // premultiplied alpha so the minified edges do not darken
+                Texture_2D::Options atlas_options;
+
+                atlas_options.mipmaps       = true;
+                atlas_options.premultiplied = true;
+
+                button_atlas = Asset_Cache::get_instance ().get_atlas (context, buttons_atlas_path, atlas_options);
+
+                // If the atlas is available, the menu option data is initialized. The state becomes READY once the background is uploaded
+                if (button_atlas)
                 {
                     configure_options ();
                 }
+                else
+                    state = ERROR;
+
+                // The decoded images are no longer needed once the textures exist
+                Asset_Loader::get_instance ().clear ();
             }
         }
     }
@@ -6,6 +6,7 @@
 #ifndef MENU_SCENE_HEADER
 #define MENU_SCENE_HEADER
 
+    #include <future>
     #include <memory>
 
     #include <basics/Atlas>
@@ -79,7 +80,9 @@
 
             shared_ptr< Texture_2D > background_texture;        ///< Texture with the background image
 
-            unique_ptr< Atlas >      button_atlas;              ///< Atlas with the menu options images
+            shared_ptr< Atlas >      button_atlas;              ///< Atlas with the menu options images
+
+            shared_future< bool >    loading;                   ///< Completes when the scene files have been read and decoded
 
         public:
 
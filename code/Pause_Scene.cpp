@@ -3,6 +3,7 @@
  * Copyright © 2020+ Mariana Moreira
  */
 
+#include <basics/Asset_Cache>
 #include <basics/Canvas>
 #include <basics/Director>
 #include <basics/Transformation>
@@ -117,22 +118,32 @@ namespace flip
 
                 canvas_width = unsigned(canvas_height * real_aspect_ratio);
 
-                // Loads the pause texture
-                pause_texture  = Texture_2D::create (ID(pause_texture),  context, pause_path);              // Loads the pause texture
-                button_texture = Texture_2D::create (ID(button_texture), context, button_path);             // Loads the button texture
+                // Loads the pause texture. The textures and the atlas are shared with the other scenes through the asset cache
+                Texture_2D::Options pause_options;
 
-                context->add(pause_texture);
-                context->add(button_texture);
+                pause_options.format = Texture_2D::RGB565;
+                pause_options.dither = true;
+
+                pause_texture  = Asset_Cache::get_instance ().get_texture (context, pause_path, pause_options);     // Loads the pause texture
+                button_texture = Asset_Cache::get_instance ().get_texture (context, button_path);             // Loads the button texture
+
+                if (!pause_texture || !button_texture) { state = ERROR; return; }
 
                 // button sprite
                 home_button.reset(new Sprite(button_texture.get()));
                 home_button->set_position({ canvas_width - 50.f, canvas_height - 50.f });
 
-                // Loads the menu buttons atlas
-                button_atlas.reset (new Atlas(buttons_atlas_path, context));
+                // Loads the menu buttons atlas with mipmaps, as the pressed options are drawn minified, and
+                // premultiplied alpha so the minified edges do not darken
+                Texture_2D::Options atlas_options;
+
+                atlas_options.mipmaps       = true;
+                atlas_options.premultiplied = true;
+
+                button_atlas = Asset_Cache::get_instance ().get_atlas (context, buttons_atlas_path, atlas_options);
 
                 // If the atlas could be loaded then the state is READY if not the is ERROR
-                state = button_atlas->good () ? READY : ERROR;
+                state = button_atlas ? READY : ERROR;
 
                 // If the atlas is available, the menu option data is initialized
                 if (state == READY)
@@ -83,7 +83,7 @@
 
             shared_ptr< Sprite >     home_button;               ///< Home button sprite
 
-            unique_ptr< Atlas >      button_atlas;              ///< Atlas with the menu options images
+            shared_ptr< Atlas >      button_atlas;              ///< Atlas with the menu options images
 
         public:
 
@@ -0,0 +1,30 @@
+/*
+ * ACCELEROMETER
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610181100
+ */
+
+#include <basics/Accelerometer>
+
+namespace basics
+{
+
+    // En escritorio no hay acelerómetro:
+
+    bool Accelerometer::is_available ()
+    {
+        return false;
+    }
+
+    Accelerometer * Accelerometer::get_instance ()
+    {
+        return nullptr;
+    }
+
+}
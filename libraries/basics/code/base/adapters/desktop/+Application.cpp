@@ -0,0 +1,32 @@
+/*
+ * APPLICATION
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610181100
+ */
+
+#include "Desktop_Application.hpp"
+
+namespace basics
+{
+
+    namespace internal
+    {
+
+        Desktop_Application application;
+
+    }
+
+    Application & Application::get_instance ()
+    {
+        return internal::application;
+    }
+
+    Application & application = Application::get_instance ();
+
+}
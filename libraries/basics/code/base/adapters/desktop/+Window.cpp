@@ -0,0 +1,65 @@
+/*
+ * WINDOW
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610181100
+ */
+
+#include <map>
+#include <basics/Application>
+#include <basics/Window>
+#include "Desktop_Window.hpp"
+
+namespace basics
+{
+
+    namespace
+    {
+
+        std::map< Id, std::shared_ptr< Window > > windows;
+
+    }
+
+    const bool Window::can_be_instantiated = true;
+
+    Window::Handle Window::create_window (Id id)
+    {
+        std::shared_ptr< Window > & window = windows[id];
+
+        // La aplicación recibe el aviso de que la ventana existe igual que en Android:
+
+        if (!window)
+        {
+            window.reset (new internal::Desktop_Window(id));
+
+            application.push (Event(Application::WINDOW_CREATED));
+        }
+
+        return Handle(window);
+    }
+
+    bool Window::destroy_window (Id id)
+    {
+        if (windows.erase (id) > 0)
+        {
+            application.push (Event(Application::WINDOW_DESTROYED));
+
+            return true;
+        }
+
+        return false;
+    }
+
+    Window::Handle Window::get_window (Id id)
+    {
+        auto window = windows.find (id);
+
+        return window != windows.end () ? Handle(window->second) : Handle();
+    }
+
+}
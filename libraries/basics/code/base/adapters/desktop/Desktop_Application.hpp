@@ -0,0 +1,45 @@
+/*
+ * DESKTOP APPLICATION
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610181100
+ */
+
+#ifndef BASICS_DESKTOP_APPLICATION_HEADER
+#define BASICS_DESKTOP_APPLICATION_HEADER
+
+    #include <basics/Application>
+
+    namespace basics { namespace internal
+    {
+
+        /**
+         * Aplicación de escritorio sin ciclo de vida propio: está activa desde que se crea hasta que
+         * alguien envía el evento QUIT.
+         */
+        class Desktop_Application : public Application
+        {
+        public:
+
+            Desktop_Application()
+            {
+                push (Event(RESUME));
+            }
+
+            State get_state () const override
+            {
+                return INTERACTIVE;
+            }
+
+        };
+
+        extern Desktop_Application application;
+
+    }}
+
+#endif
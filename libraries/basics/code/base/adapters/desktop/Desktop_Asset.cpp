@@ -0,0 +1,101 @@
+/*
+ * DESKTOP ASSET
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610181100
+ */
+
+#include "Desktop_Asset.hpp"
+
+namespace basics { namespace internal
+{
+
+    Desktop_Asset::Desktop_Asset(const std::string & path)
+    :
+        file  (path, std::ios::binary),
+        length(0)
+    {
+        if (file)
+        {
+            file.seekg (0, std::ios::end);
+
+            length = size_t(file.tellg ());
+
+            file.seekg (0, std::ios::beg);
+        }
+    }
+
+    bool Desktop_Asset::good () const
+    {
+        return file.good ();
+    }
+
+    bool Desktop_Asset::fail () const
+    {
+        return file.fail ();
+    }
+
+    bool Desktop_Asset::eof () const
+    {
+        return file.eof ();
+    }
+
+    size_t Desktop_Asset::size () const
+    {
+        return length;
+    }
+
+    bool Desktop_Asset::seek (ptrdiff_t offset, Anchor anchor)
+    {
+        file.clear ();
+        file.seekg (std::streamoff(offset), anchor == BEGINNING ? std::ios::beg : anchor == END ? std::ios::end : std::ios::cur);
+
+        return good ();
+    }
+
+    size_t Desktop_Asset::tell () const
+    {
+        return good () ? size_t(file.tellg ()) : length;
+    }
+
+    byte Desktop_Asset::read ()
+    {
+        char data = 0;
+
+        read (&data, 1);
+
+        return byte(data);
+    }
+
+    bool Desktop_Asset::read_all (std::vector< byte > & buffer)
+    {
+        buffer.resize (length);
+
+        return seek (0, BEGINNING) && read (reinterpret_cast< char * >(buffer.data ()), length);
+    }
+
+    bool Desktop_Asset::read_all (std::string & buffer)
+    {
+        buffer.resize (length);
+
+        return seek (0, BEGINNING) && read (&buffer[0], length);
+    }
+
+    bool Desktop_Asset::read (char * buffer, size_t size)
+    {
+        if (size > 0)
+        {
+            file.read (buffer, std::streamsize(size));
+
+            return size_t(file.gcount ()) == size;
+        }
+
+        return true;
+    }
+
+}}
@@ -0,0 +1,57 @@
+/*
+ * DESKTOP ASSET
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610181100
+ */
+
+#ifndef BASICS_DESKTOP_ASSET_HEADER
+#define BASICS_DESKTOP_ASSET_HEADER
+
+    #include <fstream>
+    #include <basics/Asset>
+
+    namespace basics { namespace internal
+    {
+
+        /**
+         * Asset leído de un archivo normal. Las rutas se interpretan a partir del directorio de
+         * trabajo, que debe ser la carpeta de assets del juego.
+         */
+        class Desktop_Asset final : public Asset
+        {
+
+            mutable std::ifstream file;
+            size_t                length;
+
+        public:
+
+            Desktop_Asset(const std::string & path);
+
+        public:
+
+            bool   good () const override;
+            bool   fail () const override;
+            bool   eof  () const override;
+
+            size_t size () const override;
+            bool   seek (ptrdiff_t offset, Anchor = CURRENT) override;
+            size_t tell () const override;
+            byte   read () override;
+            bool   read_all (std::vector< byte > & buffer) override;
+            bool   read_all (std::string & buffer) override;
+
+        private:
+
+            bool read (char * buffer, size_t size);
+
+        };
+
+    }}
+
+#endif
@@ -0,0 +1,45 @@
+/*
+ * DESKTOP WINDOW
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610181100
+ */
+
+#ifndef BASICS_DESKTOP_WINDOW_HEADER
+#define BASICS_DESKTOP_WINDOW_HEADER
+
+    #include <basics/Headless_Window>
+
+    namespace basics { namespace internal
+    {
+
+        /**
+         * Ventana de escritorio sin superficie: se usa con Headless_Context para ejecutar las escenas
+         * fuera del dispositivo. Tiene el foco desde que se crea.
+         */
+        class Desktop_Window final : public Headless_Window
+        {
+        public:
+
+            static const unsigned default_width  = 1280;
+            static const unsigned default_height =  720;
+
+        public:
+
+            Desktop_Window(Id id)
+            :
+                Headless_Window(id, { default_width, default_height })
+            {
+                event_queue.push (Event(GOT_FOCUS));
+            }
+
+        };
+
+    }}
+
+#endif
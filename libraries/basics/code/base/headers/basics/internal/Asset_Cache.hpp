@@ -0,0 +1,164 @@
+/*
+ * ASSET CACHE
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610181000
+ */
+
+#ifndef BASICS_ASSET_CACHE_HEADER
+#define BASICS_ASSET_CACHE_HEADER
+
+    #include <list>
+    #include <map>
+    #include <memory>
+    #include <string>
+    #include <vector>
+    #include <basics/Atlas>
+    #include <basics/Graphics_Context>
+    #include <basics/Non_Copyable>
+    #include <basics/Raster_Font>
+    #include <basics/Texture_2D>
+
+    namespace basics
+    {
+
+        /**
+         * Comparte entre escenas las texturas, los atlas y las fuentes cargados a partir de un asset,
+         * de modo que al cambiar de escena se reutilice lo que ya está en la GPU en lugar de volver a
+         * leerlo y subirlo. Cada asset se identifica por su ruta y por las opciones con las que se
+         * crean sus texturas, de modo que la misma ruta pedida con otras opciones es otro asset.
+         * Los assets que ninguna escena usa se mantienen mientras quepan en el presupuesto de memoria.
+         * Cuando se supera, se liberan empezando por los que hace más tiempo que no se piden. Eso se
+         * comprueba al añadir un asset y con trim(), que el Director llama al cambiar de escena.
+         * Solo se debe usar desde el hilo de las escenas y con el contexto gráfico bloqueado.
+         */
+        class Asset_Cache : Non_Copyable
+        {
+
+            typedef std::list< std::string > Usage_List;             ///< Claves de la más a la menos usada.
+
+            struct Entry
+            {
+                std::shared_ptr< Texture_2D  > texture;
+                std::shared_ptr< Atlas       > atlas;
+                std::shared_ptr< Raster_Font > font;
+                std::weak_ptr  < void        > users;       ///< Punteros entregados (ver lend()).
+                size_t                         size;
+                Usage_List::iterator           usage;
+            };
+
+        public:
+
+            static Asset_Cache & get_instance ();
+
+        private:
+
+            std::map< std::string, Entry > entries;             ///< Por clave (ver key_of()).
+            Usage_List                     usage;
+            size_t                         budget;
+            size_t                         resident_size;
+
+        private:
+
+            Asset_Cache();
+
+        public:
+
+            /**
+             * Retorna la textura de un asset, creándola y añadiéndola al contexto si no estaba.
+             * @param options Si se pide la misma ruta con otras opciones se crea otra textura.
+             * @return nullptr si no se pudo crear.
+             */
+            std::shared_ptr< Texture_2D  > get_texture (Graphics_Context::Accessor & context, const std::string & path, const Texture_2D::Options & options = {});
+
+            /**
+             * Retorna el atlas de un .sprites, creándolo si no estaba con las mismas opciones de
+             * textura. Retorna nullptr si no es válido.
+             */
+            std::shared_ptr< Atlas       > get_atlas   (Graphics_Context::Accessor & context, const std::string & path, const Texture_2D::Options & options = {});
+
+            /** Retorna la fuente de un .fnt, creándola si no estaba. Retorna nullptr si no es válida. */
+            std::shared_ptr< Raster_Font > get_font    (Graphics_Context::Accessor & context, const std::string & path);
+
+            /** Indica si ya hay algún asset cargado con la ruta indicada (con cualesquiera opciones). */
+            bool contains (const std::string & path) const;
+
+            /**
+             * Retorna las rutas de la lista que todavía no están en la caché. Sirve para pedir a
+             * Asset_Loader solo los archivos que hace falta leer.
+             */
+            std::vector< std::string > missing (const std::vector< std::string > & paths) const;
+
+            /** Establece cuántos bytes pueden ocupar en total los assets. Por defecto son 32 MB. */
+            void set_budget (size_t bytes)
+            {
+                budget = bytes;
+            }
+
+            size_t get_budget () const
+            {
+                return budget;
+            }
+
+            /** Bytes aproximados que ocupan los assets de la caché (en uso o no). */
+            size_t get_resident_size () const
+            {
+                return resident_size;
+            }
+
+            /** Libera los assets que no se están usando hasta que el total quepa en el presupuesto. */
+            void trim  (Graphics_Context::Accessor & context);
+
+            /** Libera todos los assets que no se están usando. */
+            void clear (Graphics_Context::Accessor & context);
+
+        private:
+
+            /**
+             * Clave de un asset: su ruta seguida de un '\0' (que no aparece en las rutas) y de las
+             * opciones que cambian la textura que se crea.
+             */
+            static std::string key_of (const std::string & path, const Texture_2D::Options & options);
+
+            Entry & touch   (const std::string & key);
+            void    measure (Entry & entry);
+            void    evict   (Graphics_Context::Accessor & context, size_t limit);
+
+            /** Un asset está en uso mientras exista alguno de los punteros entregados con lend(). */
+            bool in_use (const Entry & entry) const
+            {
+                return !entry.users.expired ();
+            }
+
+            /**
+             * Retorna el puntero que se entrega a quien pide un asset. No comparte el contador de
+             * referencias con el de la caché (ni con los del contexto gráfico), sino que tiene uno
+             * propio que mantiene vivo al asset a través de la referencia de la caché. Así se sabe si
+             * alguien lo usa sin suponer cuántas referencias más tiene.
+             */
+            template< typename TYPE >
+            static std::shared_ptr< TYPE > lend (const std::shared_ptr< TYPE > & asset, Entry & entry)
+            {
+                if (!asset) return asset;
+
+                std::shared_ptr< void > users = entry.users.lock ();
+
+                if (users) return std::static_pointer_cast< TYPE >(users);
+
+                std::shared_ptr< TYPE > lent(asset.get (), [asset] (TYPE * ) { });
+
+                entry.users = lent;
+
+                return lent;
+            }
+
+        };
+
+    }
+
+#endif
@@ -0,0 +1,130 @@
+/*
+ * ASSET LOADER
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610172010
+ */
+
+#ifndef BASICS_ASSET_LOADER_HEADER
+#define BASICS_ASSET_LOADER_HEADER
+
+    #include <atomic>
+    #include <condition_variable>
+    #include <deque>
+    #include <functional>
+    #include <future>
+    #include <map>
+    #include <memory>
+    #include <mutex>
+    #include <string>
+    #include <thread>
+    #include <vector>
+    #include <basics/Color_Buffer>
+    #include <basics/Non_Copyable>
+    #include <basics/Texture_2D>
+    #include <basics/types>
+
+    namespace basics
+    {
+
+        /**
+         * Lee y decodifica archivos en segundo plano con un pequeño conjunto de hilos de trabajo, de
+         * modo que en el hilo del contexto gráfico solo quede la subida de las texturas a la GPU.
+         * Los PNG se decodifican a un Color_Buffer. De los archivos .sprites y .fnt se guarda su
+         * contenido y además se decodifica la textura a la que hacen referencia.
+         * Texture_2D::create(), Atlas y Raster_Font buscan primero aquí los datos de la ruta que se les
+         * pide y, si no están, los leen ellos mismos como antes.
+         */
+        class Asset_Loader : Non_Copyable
+        {
+        public:
+
+            typedef std::vector< byte > Buffer;
+
+            struct Image
+            {
+                Texture_2D::Options          options;
+                Color_Buffer< Rgba8888 >     color_buffer;
+                Texture_2D::Compressed_Image compressed_image;      ///< Solo si la imagen está comprimida.
+            };
+
+        private:
+
+            struct Batch
+            {
+                std::atomic< size_t > pending;
+                std::atomic< bool   > failed;
+                std::promise< bool  > done;
+            };
+
+            typedef std::function< void () > Task;
+
+        public:
+
+            static Asset_Loader & get_instance ();
+
+        private:
+
+            std::vector< std::thread > workers;
+            std::deque < Task        > tasks;
+            std::mutex                 tasks_mutex;
+            std::condition_variable    tasks_condition;
+            bool                       exit;
+
+            std::map< std::string, std::shared_ptr< const Buffer > > files;
+            std::map< std::string, std::shared_ptr< Image        > > images;
+            mutable std::mutex                                       store_mutex;
+
+        private:
+
+            Asset_Loader();
+           ~Asset_Loader();
+
+        public:
+
+            /**
+             * Encola la carga de los archivos indicados y retorna inmediatamente.
+             * @return Un future que se completa cuando todos los archivos (y las texturas de los .sprites
+             *     y .fnt) se han procesado. Su valor es false si alguno no se pudo leer o decodificar.
+             */
+            std::shared_future< bool > load (const std::vector< std::string > & paths);
+
+            /** Retorna el contenido de un archivo cargado previamente o nullptr si no está. */
+            std::shared_ptr< const Buffer > find_file  (const std::string & path) const;
+
+            /** Retorna la imagen decodificada de un PNG cargado previamente o nullptr si no está. */
+            std::shared_ptr< const Image  > find_image (const std::string & path) const;
+
+            /**
+             * Retorna la imagen decodificada de un PNG y la saca del cargador, de modo que quien la
+             * recibe se pueda quedar con sus píxeles sin copiarlos. Retorna nullptr si no está.
+             */
+            std::shared_ptr< Image > take_image (const std::string & path);
+
+            /**
+             * Descarta los datos cargados. Conviene llamarlo una vez creados los recursos a partir de
+             * ellos para no mantener en memoria una segunda copia de cada imagen.
+             */
+            void clear ();
+
+        private:
+
+            void start_workers ();
+            void enqueue       (Task task);
+            void run_worker    ();
+
+            void process       (const std::string & path, const std::shared_ptr< Batch > & batch);
+            bool load_image    (const std::string & path);
+            bool load_file     (const std::string & path, std::shared_ptr< Buffer > & data);
+            void finish        (const std::shared_ptr< Batch > & batch, bool success);
+
+        };
+
+    }
+
+#endif
@@ -13,12 +13,13 @@
 #ifndef BASICS_ATLAS_HEADER
 #define BASICS_ATLAS_HEADER
 
-    #include <map>
+    #include <deque>
     #include <memory>
     #include <string>
     #include <vector>
     #include <rapidxml.hpp>
     #include <basics/Id>
+    #include <basics/Non_Copyable>
     #include <basics/Point>
     #include <basics/Size>
     #include <basics/Texture_2D>
@@ -27,7 +28,7 @@
     namespace basics
     {
 
-        class Atlas
+        class Atlas : Non_Copyable
         {
         public:
 
@@ -44,18 +45,35 @@
 
         private:
 
+            /**
+             * Entrada del índice de slices. Las entradas libres tienen slice == nullptr.
+             */
+            struct Slot
+            {
+                Id      id;
+                Slice * slice;
+            };
+
             typedef std::shared_ptr< Texture_2D > Texture_Handle;
-            typedef std::map< Id, Slice >         Slice_Map;
-            typedef std::vector< byte >           Buffer;
+            typedef std::deque < Slice >          Slice_List;       ///< Añadir al final no mueve los slices existentes.
+            typedef std::vector< Slot  >          Slice_Index;
+            typedef std::vector< byte  >          Buffer;
 
         private:
 
             Texture_Handle texture;
-            Slice_Map      slices;
+            Slice_List     slices;
+            Slice_Index    index;                       ///< Tabla hash con sondeo lineal (tamaño potencia de 2).
+            unsigned       index_shift;                 ///< 32 - log2(index.size ()).
 
         public:
 
-            Atlas(const std::string    & path, Graphics_Context::Accessor & context);
+            /**
+             * Carga un .sprites. Si junto a él existe su versión en bruto (ver raw_atlas), se carga
+             * esta última sin parsear el XML, salvo que se haya generado a partir de un contenido del
+             * .sprites distinto del actual, en cuyo caso se registra un error y se usa el XML.
+             */
+            Atlas(const std::string    & path, Graphics_Context::Accessor & context, const Texture_2D::Options & texture_options = {});
             Atlas(const Texture_Handle & texture);
 
         public:
@@ -70,15 +88,27 @@
                 return texture;
             }
 
+            /**
+             * Busca un slice en el índice. Normalmente basta con leer una o dos entradas contiguas,
+             * porque el índice nunca está ocupado más de la mitad.
+             */
             const Slice * get_slice (Id id) const
             {
-                Slice_Map::const_iterator slice = slices.find (id);
+                if (index.empty ()) return nullptr;
+
+                size_t mask = index.size () - 1;
 
-                return slice != slices.end () ? &slice->second : nullptr;
+                for (size_t position = home_of (id); ; position = (position + 1) & mask)
+                {
+                    const Slot & slot = index[position];
+
+                    if (slot.slice == nullptr) return nullptr;
+                    if (slot.id    == id     ) return slot.slice;
+                }
             }
 
             /**
-             * Añade un nuevo slice al atlas.
+             * Añade un nuevo slice al atlas. Los punteros a los slices existentes siguen siendo válidos.
              * @param id Identificador del nuevo slice. No debe existir algún slice con el mismo id.
              * @param position Coordenadas del vértice inferior izquierdo del slice sobre la textura.
              * @param size Tamaño del slice dentro de la textura.
@@ -91,10 +121,22 @@
                 return this->good ();
             }
 
+            /** Prepara el índice para que quepan los slices indicados sin tener que rehacerlo. */
+            void reserve (size_t slice_count);
+
         private:
 
-            void parse     (Buffer           & slices_data, const std::string & path, Graphics_Context::Accessor & context);
-            void parse_img (rapidxml::xml_node<> * img_tag, const std::string & path, Graphics_Context::Accessor & context);
+            /** Posición inicial de un id en el índice (hash multiplicativo de Fibonacci). */
+            size_t home_of (Id id) const
+            {
+                return size_t(uint32_t(id * 2654435769u) >> index_shift);
+            }
+
+            void rebuild_index (size_t capacity);
+
+            bool load_raw  (const std::string & path, Graphics_Context::Accessor & context, const Texture_2D::Options & texture_options);
+            void parse     (Buffer           & slices_data, const std::string & path, Graphics_Context::Accessor & context, const Texture_2D::Options & texture_options);
+            void parse_img (rapidxml::xml_node<> * img_tag, const std::string & path, Graphics_Context::Accessor & context, const Texture_2D::Options & texture_options);
             void parse_dir (rapidxml::xml_node<> * dir_tag, const std::string & prefix = std::string());
             void parse_spr (rapidxml::xml_node<> * spr_tag, const std::string & id);
 
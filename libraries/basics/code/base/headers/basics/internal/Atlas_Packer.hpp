@@ -0,0 +1,161 @@
+/*
+ * ATLAS PACKER
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610180910
+ */
+
+#ifndef BASICS_ATLAS_PACKER_HEADER
+#define BASICS_ATLAS_PACKER_HEADER
+
+    #include <map>
+    #include <memory>
+    #include <string>
+    #include <vector>
+    #include <basics/Atlas>
+    #include <basics/Color_Buffer>
+    #include <basics/Graphics_Context>
+    #include <basics/Id>
+    #include <basics/Non_Copyable>
+    #include <basics/Size>
+    #include <basics/Texture_2D>
+
+    namespace basics
+    {
+
+        /**
+         * Reparte rectángulos dentro de una página con el algoritmo skyline (bottom-left): se guarda
+         * la altura ocupada de cada tramo horizontal de la página y cada rectángulo se coloca sobre
+         * el tramo en el que su borde inferior queda más arriba.
+         * Las coordenadas tienen el origen en la esquina superior izquierda, como las de los .sprites.
+         */
+        class Skyline_Packer
+        {
+
+            struct Segment
+            {
+                unsigned x;
+                unsigned y;                         ///< Altura ocupada (borde inferior de lo colocado).
+                unsigned width;
+            };
+
+        private:
+
+            unsigned               width;
+            unsigned               height;
+            unsigned               used_height;
+            uint64_t               used_area;
+            std::vector< Segment > skyline;
+
+        public:
+
+            Skyline_Packer(unsigned width, unsigned height);
+
+        public:
+
+            /**
+             * Busca sitio para un rectángulo y, si lo encuentra, lo reserva.
+             * @return false si no cabe en la página.
+             */
+            bool insert (unsigned rectangle_width, unsigned rectangle_height, unsigned & x, unsigned & y);
+
+            /** Altura de la parte de la página que ocupan los rectángulos colocados. */
+            unsigned get_used_height () const
+            {
+                return used_height;
+            }
+
+            /** Fracción del área ocupada hasta get_used_height() que cubren los rectángulos. */
+            float get_occupancy () const
+            {
+                return used_height > 0 ? float(double(used_area) / (double(width) * used_height)) : 0.f;
+            }
+
+        };
+
+        /**
+         * Junta en tiempo de ejecución varias imágenes sueltas en una o más páginas de atlas, de modo
+         * que se dibujen con la misma textura y se puedan agrupar en un único draw call. Cada imagen
+         * se convierte en un Atlas::Slice, por lo que se usa igual que los slices de un .sprites.
+         * Las imágenes se leen con Texture_2D::load() (o se toman de Asset_Loader si ya se cargaron)
+         * y se rodean de un borde con sus píxeles del contorno repetidos para que el filtrado lineal
+         * no mezcle imágenes vecinas.
+         */
+        class Atlas_Packer : Non_Copyable
+        {
+
+            struct Entry
+            {
+                Id                       id;
+                std::string              path;
+                Color_Buffer< Rgba8888 > image;
+                bool                     premultiplied;
+            };
+
+        private:
+
+            Size2u                                  page_size;
+            unsigned                                border;
+            std::vector< Entry >                    entries;
+            std::vector< std::unique_ptr< Atlas > > pages;
+            std::map< Id, const Atlas::Slice * >    slices;
+
+        public:
+
+            /**
+             * @param page_size Tamaño máximo de cada página. La altura de cada página se reduce a la
+             *     potencia de 2 más pequeña en la que caben sus imágenes.
+             * @param border Píxeles repetidos alrededor de cada imagen.
+             */
+            Atlas_Packer(const Size2u & page_size = { 1024, 1024 }, unsigned border = 1);
+
+        public:
+
+            /** Añade la imagen de un asset (.png o .btex) que se leerá en pack(). */
+            void add (Id id, const std::string & asset_path);
+
+            /** Añade una imagen ya decodificada. */
+            void add (Id id, const Color_Buffer< Rgba8888 > & image, bool premultiplied = false);
+
+            /**
+             * Coloca las imágenes añadidas y crea las texturas de las páginas. Las imágenes se colocan
+             * de mayor a menor altura, que es el orden con el que skyline deja menos huecos.
+             * @param options Opciones de las texturas de las páginas (formato, filtro, mipmaps y alfa
+             *     premultiplicado). Las dimensiones y la opacidad se calculan.
+             * @return false si alguna imagen no se pudo leer, no cabe en una página o no se pudo crear
+             *     alguna textura. Las demás imágenes quedan disponibles igualmente.
+             */
+            bool pack (Graphics_Context::Accessor & context, const Texture_2D::Options & options = {});
+
+            /** Retorna el slice de una imagen empaquetada o nullptr si no existe. */
+            const Atlas::Slice * get_slice (Id id) const
+            {
+                auto slice = slices.find (id);
+
+                return slice != slices.end () ? slice->second : nullptr;
+            }
+
+            size_t get_page_count () const
+            {
+                return pages.size ();
+            }
+
+            const Atlas & get_page (size_t index) const
+            {
+                return *pages[index];
+            }
+
+        private:
+
+            void copy_image (const Color_Buffer< Rgba8888 > & image, Color_Buffer< Rgba8888 > & page, unsigned x, unsigned y) const;
+
+        };
+
+    }
+
+#endif
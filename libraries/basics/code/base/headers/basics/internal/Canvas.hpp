@@ -13,6 +13,7 @@
 #ifndef BASICS_CANVAS_HEADER
 #define BASICS_CANVAS_HEADER
 
+    #include <vector>
     #include <basics/Atlas>
     #include <basics/Graphics_Context>
     #include <basics/Point>
@@ -40,6 +41,18 @@
             FLIP_VERTICAL   = 32,
         };
 
+        /**
+         * Datos de cada una de las instancias de sprite que se dibujan con Canvas::draw_sprites().
+         */
+        struct Sprite_Instance
+        {
+            const Atlas::Slice * slice;                 ///< Región del atlas que se dibuja (define las coordenadas de textura).
+            Point2f              position;              ///< Punto de referencia indicado por el anclaje.
+            Size2f               size;                  ///< Tamaño con el que se dibuja la instancia.
+            float                opacity;               ///< Opacidad con la que se dibuja la instancia.
+            int                  handling;              ///< Anclaje (Anchor) y volteos (FLIP_HORIZONTAL/FLIP_VERTICAL).
+        };
+
         struct Canvas : public Renderer
         {
         public:
@@ -101,6 +114,28 @@
             virtual void set_transform   (const Transformation2f & transform) { }
             virtual void apply_transform (const Transformation2f & transform) { }
 
+            /** Opacidad con la que se dibujan los draws siguientes. */
+            virtual float get_opacity    () const { return 1.f; }
+
+        public:
+
+            /**
+             * Activa o desactiva el envío diferido y ordenado de los draws. Mientras está activo, los
+             * draws se acumulan y, al terminar el fotograma (o al desactivarlo), se envían ordenados
+             * por capa y profundidad y, dentro de ellas, agrupados por shader program, textura y modo
+             * de mezcla. Un draw solo se agrupa con otro anterior si no se solapa con los que hay entre
+             * ambos, por lo que el resultado es el mismo que dibujando en el orden de petición.
+             * Las especializaciones que no lo admiten dibujan en el orden en que reciben los draws.
+             */
+            virtual void set_sorting     (bool /*enabled*/) { }
+
+            /**
+             * Establece la capa y la profundidad con las que se etiquetan los draws siguientes cuando
+             * el envío ordenado está activo. Las capas (y las profundidades de una misma capa) menores
+             * se dibujan antes.
+             */
+            virtual void set_layer       (int /*layer*/, float /*depth*/ = 0.f) { }
+
         public:
 
             virtual void clear           () { }
@@ -114,6 +149,30 @@
             virtual void fill_rectangle  (const Point2f & where, const Size2f & size, const Atlas::Slice * slice,   int handling = CENTER) { }
             virtual void draw_text       (const Point2f & where, const Text_Layout & text_layout, int handling = TOP | LEFT);
 
+            /**
+             * Dibuja una serie de sprites con una única llamada. Cada instancia se dibuja con su propia
+             * opacidad, que sustituye a la del canvas, y al terminar se restaura la opacidad que tenía
+             * el canvas.
+             * La implementación por defecto dibuja cada instancia con fill_rectangle() tras cambiar la
+             * opacidad del canvas, por lo que solo conviene a canvas en los que cambiarla es barato.
+             * Las especializaciones pueden agruparlas en un único draw call o llevar la opacidad de
+             * cada instancia en sus vértices.
+             */
+            virtual void draw_sprites    (const Sprite_Instance * instances, size_t count);
+
+            void draw_sprites (const std::vector< Sprite_Instance > & instances)
+            {
+                draw_sprites (instances.data (), instances.size ());
+            }
+
+        protected:
+
+            /**
+             * Calcula la posición de la esquina superior izquierda de un texto a partir del punto de
+             * referencia y del anclaje que se indiquen al llamar a draw_text().
+             */
+            static Point2f get_text_top_left (const Point2f & where, const Text_Layout & text_layout, int handling);
+
         };
 
     }
@@ -13,6 +13,7 @@
 #ifndef BASICS_COLOR_BUFFER_HEADER
 #define BASICS_COLOR_BUFFER_HEADER
 
+    #include <utility>
     #include <vector>
     #include <basics/Color>
 
@@ -51,6 +52,35 @@
             {
             }
 
+            Color_Buffer(const Color_Buffer & ) = default;
+
+            /** Toma los píxeles de otro buffer sin copiarlos. El otro buffer queda vacío. */
+            Color_Buffer(Color_Buffer && other)
+            :
+                width (other.width ),
+                height(other.height),
+                buffer(std::move (other.buffer))
+            {
+                other.width  = 0;
+                other.height = 0;
+                other.buffer.clear ();
+            }
+
+            Color_Buffer & operator = (const Color_Buffer & ) = default;
+
+            Color_Buffer & operator = (Color_Buffer && other)
+            {
+                width  = other.width;
+                height = other.height;
+                buffer = std::move (other.buffer);
+
+                other.width  = 0;
+                other.height = 0;
+                other.buffer.clear ();
+
+                return *this;
+            }
+
         public:
 
             unsigned size () const
@@ -13,6 +13,7 @@
 #ifndef BASICS_GRAPHICS_CONTEXT_HEADER
 #define BASICS_GRAPHICS_CONTEXT_HEADER
 
+    #include <algorithm>
     #include <map>
     #include <memory>
     #include <mutex>
@@ -24,6 +25,7 @@
     #include <basics/Graphics_Resource_Cache>
     #include <basics/Id>
     #include <basics/Point>
+    #include <basics/Renderer>
     #include <basics/Size>
     #include <basics/types>
 
@@ -134,6 +136,7 @@
             Window                  & window;
             Renderer_List             renderers;
             Resource_List             resources;
+            Resource_List             pending_uploads;          ///< Recursos que se siguen subiendo por partes.
             Graphics_Resource_Cache * graphics_resource_cache;
 
         protected:
@@ -162,6 +165,14 @@
                 return renderers.find (id) == renderers.end () ? renderers[id] = renderer, true : false;
             }
 
+            void flush_renderers ()
+            {
+                for (auto & renderer : renderers)
+                {
+                    renderer.second->flush ();
+                }
+            }
+
             // CUIDADO CON AÑADIR DUPLICADOS. PODRÍA ESTAR BIEN QUE CADA RECURSO TUVIESE UN Id ÚNICO Y
             // AÑADIRLOS A UN MAPA PARA EVITAR DUPLICIDADES.
             bool add (const std::shared_ptr< Graphics_Resource > & resource)
@@ -170,12 +181,40 @@
                 {
                     resources.push_back (resource);
 
-                    return resource->initialize ();
+                    if (!resource->initialize ()) return false;
+
+                    if (!resource->is_ready () && std::find (pending_uploads.begin (), pending_uploads.end (), resource) == pending_uploads.end ())
+                    {
+                        pending_uploads.push_back (resource);
+                    }
+
+                    return true;
                 }
 
                 return false;
             }
 
+            /**
+             * Quita un recurso añadido con add(). Si nadie más lo usa, se destruye y libera su memoria,
+             * por lo que el contexto debe estar bloqueado.
+             */
+            void remove (const std::shared_ptr< Graphics_Resource > & resource)
+            {
+                resources      .erase (std::remove (resources      .begin (), resources      .end (), resource), resources      .end ());
+                pending_uploads.erase (std::remove (pending_uploads.begin (), pending_uploads.end (), resource), pending_uploads.end ());
+            }
+
+            /**
+             * Continúa la subida de los recursos que se suben por partes, en el orden en que se
+             * añadieron, durante el tiempo indicado. Director lo llama una vez en cada fotograma.
+             */
+            void process_uploads (float budget_seconds);
+
+            bool has_pending_uploads () const
+            {
+                return !pending_uploads.empty ();
+            }
+
         public:
 
             virtual void initialize ()
@@ -191,6 +230,8 @@
 
             virtual void finalize ()
             {
+                pending_uploads.clear ();
+
                 if (graphics_resource_cache)
                 {
                     for (auto iterator = graphics_resource_cache->begin (); iterator != graphics_resource_cache->end (); ++iterator)
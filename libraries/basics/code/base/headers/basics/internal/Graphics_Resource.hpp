@@ -38,6 +38,26 @@
             virtual bool initialize (/*Graphics_Context & context*/) = 0;
             virtual void finalize   () = 0;
 
+            /**
+             * Indica si el recurso se puede usar ya. Los recursos que se suben a la GPU en varias
+             * partes (ver continue_upload()) quedan inicializados sin estar listos hasta la última.
+             */
+            virtual bool is_ready () const
+            {
+                return initialized;
+            }
+
+            /**
+             * Sube la siguiente parte de un recurso que no está listo. Se sube al menos una parte
+             * aunque se agote el tiempo, de modo que la subida siempre avanza.
+             * @param budget_seconds Tiempo aproximado que se puede emplear.
+             * @return true si el recurso ha quedado listo.
+             */
+            virtual bool continue_upload (float /*budget_seconds*/)
+            {
+                return true;
+            }
+
         };
 
     }
@@ -0,0 +1,118 @@
+/*
+ * HEADLESS CONTEXT
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610171520
+ */
+
+#ifndef BASICS_HEADLESS_CONTEXT_HEADER
+#define BASICS_HEADLESS_CONTEXT_HEADER
+
+    #include <basics/Graphics_Context>
+    #include <basics/Window>
+
+    namespace basics
+    {
+
+        /**
+         * Contexto gráfico que no usa la GPU. Su Id determina qué especializaciones de Canvas y de
+         * Texture_2D se crean a través de él: ID(recording) para grabar comandos (por defecto) o
+         * ID(software) para rasterizar por CPU.
+         * Director::set_graphics_context_factory (Headless_Context::create) permite ejecutar las
+         * escenas sin OpenGL ES.
+         */
+        class Headless_Context : public Graphics_Context
+        {
+        public:
+
+            /** Id del backend con el que create() crea los nuevos contextos. */
+            static Id default_backend_id;
+
+            static bool create (Window::Accessor & window, Graphics_Resource_Cache * cache);
+
+        private:
+
+            Id   backend_id;
+            bool available;
+
+        public:
+
+            Headless_Context(Window & window, Graphics_Resource_Cache * cache, Id backend_id = default_backend_id)
+            :
+                Graphics_Context(window, cache),
+                backend_id      (backend_id),
+                available       (true)
+            {
+            }
+
+           ~Headless_Context() override = default;
+
+        public:
+
+            void invalidate () override { }
+
+            void suspend () override
+            {
+                available = false;
+            }
+
+            bool resume () override
+            {
+                return available = true;
+            }
+
+            bool is_available () const override
+            {
+                return available;
+            }
+
+            bool is_current () const override
+            {
+                return true;
+            }
+
+            Id get_id () const override
+            {
+                return backend_id;
+            }
+
+            unsigned get_surface_width () override
+            {
+                return window.get_width ();
+            }
+
+            unsigned get_surface_height () override
+            {
+                return window.get_height ();
+            }
+
+            bool set_sync_swap (bool ) override
+            {
+                return false;
+            }
+
+            void reset_viewport () override { }
+            void set_viewport   (const Point2u & , const Size2u & ) override { }
+
+            bool make_current () override
+            {
+                return available;
+            }
+
+            bool flush_and_display () override
+            {
+                if (available) flush_renderers ();
+
+                return available;
+            }
+
+        };
+
+    }
+
+#endif
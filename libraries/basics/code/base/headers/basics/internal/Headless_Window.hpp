@@ -0,0 +1,64 @@
+/*
+ * HEADLESS WINDOW
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610171515
+ */
+
+#ifndef BASICS_HEADLESS_WINDOW_HEADER
+#define BASICS_HEADLESS_WINDOW_HEADER
+
+    #include <basics/Window>
+
+    namespace basics
+    {
+
+        /**
+         * Ventana sin superficie real que permite crear un Headless_Context en plataformas sin gestor
+         * de ventanas (por ejemplo, en un servidor de integración continua).
+         */
+        class Headless_Window : public Window
+        {
+
+            Size2u size;
+
+        public:
+
+            Headless_Window(Id id, const Size2u & size)
+            :
+                Window(id),
+                size  (size)
+            {
+                available = true;
+                focused   = true;
+            }
+
+           ~Headless_Window() override = default;
+
+        public:
+
+            Size2u get_size () override
+            {
+                return size;
+            }
+
+            unsigned get_width () override
+            {
+                return size.width;
+            }
+
+            unsigned get_height () override
+            {
+                return size.height;
+            }
+
+        };
+
+    }
+
+#endif
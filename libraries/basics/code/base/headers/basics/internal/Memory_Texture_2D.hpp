@@ -0,0 +1,72 @@
+/*
+ * MEMORY TEXTURE 2D
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610171500
+ */
+
+#ifndef BASICS_MEMORY_TEXTURE_2D_HEADER
+#define BASICS_MEMORY_TEXTURE_2D_HEADER
+
+    #include <basics/Texture_2D>
+
+    namespace basics
+    {
+
+        /**
+         * Textura que conserva sus píxeles en memoria principal en lugar de subirlos a la GPU. La usan
+         * los contextos gráficos que no disponen de GPU (grabación de comandos, rasterizado por CPU).
+         */
+        class Memory_Texture_2D : public Texture_2D
+        {
+        public:
+
+            static std::shared_ptr< Texture_2D > create (Id id, Color_Buffer< Rgba8888 > & color_buffer, const Options & options);
+
+            static void enable (Id context_id)
+            {
+                register_factory (context_id, Memory_Texture_2D::create);
+            }
+
+        private:
+
+            Color_Buffer< Rgba8888 > color_buffer;
+
+        public:
+
+            Memory_Texture_2D(Color_Buffer< Rgba8888 > color_buffer, unsigned width, unsigned height, bool opaque = false, bool premultiplied = false)
+            :
+                Texture_2D  (width, height, opaque, premultiplied),
+                color_buffer(std::move (color_buffer))
+            {
+            }
+
+        public:
+
+            bool initialize () override
+            {
+                return initialized = color_buffer.size () > 0;
+            }
+
+            void finalize () override
+            {
+                initialized = false;
+            }
+
+        public:
+
+            const Color_Buffer< Rgba8888 > & get_color_buffer () const
+            {
+                return color_buffer;
+            }
+
+        };
+
+    }
+
+#endif
@@ -13,8 +13,9 @@
 #ifndef BASICS_RASTER_FONT_HEADER
 #define BASICS_RASTER_FONT_HEADER
 
+    #include <array>
+    #include <atomic>
     #include <memory>
-    #include <unordered_map>
     #include <vector>
     #include <basics/Atlas>
     #include <basics/Font>
@@ -42,18 +43,32 @@
 
         private:
 
-            typedef std::unordered_map< uint32_t, Character > Character_Map;
-            typedef std::vector< byte >                       Buffer;
-            typedef std::unique_ptr< Atlas >                  Atlas_Handle;
+            /**
+             * Los caracteres se guardan en páginas de 256 códigos consecutivos. Los que no existen
+             * tienen slice == nullptr.
+             */
+            typedef std::array < Character, 256 >                    Character_Page;
+            typedef std::vector< std::unique_ptr< Character_Page > > Page_Table;
+            typedef std::vector< byte >                              Buffer;
+            typedef std::unique_ptr< Atlas >                         Atlas_Handle;
 
         private:
 
-            Character_Map character_map;
-            Atlas_Handle  atlas;
-            Metrics       metrics;
+            Character_Page latin_1;                 ///< Códigos 0 a 255, que son los de casi todos los textos.
+            Page_Table     pages;                   ///< Resto de Unicode indexado por code >> 8 (se crean bajo demanda).
+            Atlas_Handle   atlas;
+            Metrics        metrics;
+            uint32_t       serial;                  ///< Distinto en cada fuente creada (ver get_serial()).
+
+            static std::atomic< uint32_t > next_serial;
 
         public:
 
+            /**
+             * Carga un .fnt de BMFont en XML. Si junto a él existe su versión en bruto (ver raw_font),
+             * se carga esta última sin parsear el XML, salvo que se haya generado a partir de un
+             * contenido del .fnt distinto del actual, en cuyo caso se registra un error y se usa el XML.
+             */
             Raster_Font(const std::string & path, Graphics_Context::Accessor & context);
 
         public:
@@ -63,15 +78,47 @@
                 return metrics;
             }
 
+            /**
+             * Número que identifica a esta fuente entre todas las creadas. A diferencia de su
+             * dirección, no se repite aunque la fuente se destruya y otra ocupe su memoria, por lo que
+             * sirve para saber si los slices obtenidos de una fuente siguen siendo válidos.
+             */
+            uint32_t get_serial () const
+            {
+                return serial;
+            }
+
+            /** Retorna el atlas con las imágenes de los caracteres o nullptr si no se pudo cargar. */
+            const Atlas * get_atlas () const
+            {
+                return atlas.get ();
+            }
+
             const Character * get_character (uint32_t code) const
             {
-                Character_Map::const_iterator item = character_map.find (code);
+                const Character * character;
+
+                if (code < 256)
+                {
+                    character = &latin_1[code];
+                }
+                else
+                {
+                    size_t page = code >> 8;
+
+                    if (page >= pages.size () || !pages[page]) return nullptr;
 
-                return item != character_map.end () ? &item->second : nullptr;
+                    character = &(*pages[page])[code & 255];
+                }
+
+                return character->slice ? character : nullptr;
             }
 
         private:
 
+            Character * add_character (uint32_t code);
+
+            bool load_raw     (const std::string & path, Graphics_Context::Accessor & context);
             bool parse        (Buffer & font_data, const std::string & path, Graphics_Context::Accessor & context);
             bool parse_font   (rapidxml::xml_node<> *   font_tag, const std::string & path, Graphics_Context::Accessor & context);
             bool parse_pages  (rapidxml::xml_node<> *  pages_tag, const std::string & path, Graphics_Context::Accessor & context);
@@ -0,0 +1,227 @@
+/*
+ * RECORDING CANVAS
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610171410
+ */
+
+#ifndef BASICS_RECORDING_CANVAS_HEADER
+#define BASICS_RECORDING_CANVAS_HEADER
+
+    #include <cstring>
+    #include <map>
+    #include <vector>
+    #include <basics/Canvas>
+    #include <basics/types>
+
+    namespace basics
+    {
+
+        /**
+         * Canvas que no dibuja nada: guarda cada operación que recibe en un buffer binario compacto de
+         * comandos que se puede reproducir más tarde sobre otro canvas (por ejemplo, Canvas_ES2).
+         * Permite ejecutar el render de una escena sin GPU para contar draw calls, cambios de estado y
+         * bytes por fotograma, comparar la carga de trabajo de distintas versiones o medir el coste
+         * del dibujado por separado de la simulación.
+         * Los comandos no guardan punteros: cada textura y cada slice de atlas (incluidos los glifos
+         * de las fuentes) se guarda como su posición en una tabla de recursos (Resource_Table) que
+         * se llena en el orden en que se usan por primera vez, por lo que dos grabaciones de la
+         * misma escena producen los mismos bytes. Para reproducir los comandos hace falta esa tabla
+         * o una equivalente con los recursos del proceso que los reproduce.
+         */
+        class Recording_Canvas : public Canvas
+        {
+        public:
+
+            enum Command : byte
+            {
+                SET_SIZE,
+                SET_CLEAR_COLOR,
+                SET_COLOR,
+                SET_OPACITY,
+                SET_BLENDING,
+                SET_TRANSFORM,
+                APPLY_TRANSFORM,
+                CLEAR,
+                DRAW_POINT,
+                DRAW_SEGMENT,
+                DRAW_TRIANGLE,
+                FILL_TRIANGLE,
+                DRAW_RECTANGLE,
+                FILL_RECTANGLE,
+                FILL_TEXTURED_RECTANGLE,
+                FILL_SLICE_RECTANGLE,
+                DRAW_TEXT,
+                END_OF_FRAME,
+                SET_SORTING,
+                SET_LAYER,
+                DRAW_SPRITES,
+            };
+
+            struct Statistics
+            {
+                size_t frames;
+                size_t draws;                   ///< Primitivas dibujadas (cada glifo de un texto cuenta como una).
+                size_t state_changes;           ///< Llamadas que modifican el estado del canvas.
+                size_t bytes;                   ///< Bytes de comandos generados.
+            };
+
+            typedef std::vector< byte > Command_Buffer;
+
+            /** Valor con el que se graba un puntero a recurso nulo. */
+            static const uint32_t no_resource = 0xFFFFFFFFu;
+
+            /** Recursos a los que se refieren los comandos a través de su posición en cada lista. */
+            struct Resource_Table
+            {
+                std::vector< const Texture_2D   * > textures;
+                std::vector< const Atlas::Slice * > slices;
+            };
+
+        public:
+
+            static Canvas * create (Id id, Graphics_Context::Accessor & context, const Options & options);
+
+            static void enable (Id context_id = ID(recording))
+            {
+                register_factory (context_id, Recording_Canvas::create);
+            }
+
+            /**
+             * Reproduce sobre el canvas indicado los comandos contenidos en un buffer.
+             * @param resources Recursos a los que se refieren los comandos.
+             * @return false si el buffer está truncado, contiene algún comando desconocido o se
+             *     refiere a algún recurso que no está en la tabla. Los comandos anteriores al error
+             *     ya se habrán reproducido.
+             */
+            static bool replay (const Command_Buffer & commands, const Resource_Table & resources, Canvas & target);
+
+        private:
+
+            Command_Buffer commands;
+            Resource_Table resources;
+            std::map< const void *, uint32_t > resource_ids;
+            Statistics     total;
+            Statistics     frame;
+            Statistics     last_frame;
+            size_t         frame_start;         ///< Posición del buffer en la que empieza el fotograma actual.
+            float          opacity;             ///< Última opacidad grabada (la consulta draw_sprites()).
+
+        public:
+
+            Recording_Canvas(const Size2u & size);
+
+        public:
+
+            const Command_Buffer & get_commands () const
+            {
+                return commands;
+            }
+
+            const Resource_Table & get_resources () const
+            {
+                return resources;
+            }
+
+            /** Estadísticas acumuladas desde que se empezó a grabar. */
+            const Statistics & get_statistics () const
+            {
+                return total;
+            }
+
+            /** Estadísticas del último fotograma terminado (lo termina flush()). */
+            const Statistics & get_last_frame_statistics () const
+            {
+                return last_frame;
+            }
+
+            /** Descarta los comandos y las estadísticas acumulados hasta el momento. */
+            void reset_recording ();
+
+            bool replay (Canvas & target) const
+            {
+                return replay (commands, resources, target);
+            }
+
+        public:
+
+            void flush           () override;
+
+        public:
+
+            void set_size        (const Size2u & size) override;
+
+        public:
+
+            void set_clear_color (float r, float g, float b) override;
+            void set_color       (float r, float g, float b) override;
+            void set_opacity     (float opacity) override;
+            void set_blending    (Blending blending) override;
+            void set_transform   (const Transformation2f & transform) override;
+            void apply_transform (const Transformation2f & transform) override;
+            void set_sorting     (bool enabled) override;
+            void set_layer       (int layer, float depth = 0.f) override;
+
+            float get_opacity    () const override
+            {
+                return opacity;
+            }
+
+        public:
+
+            void clear           () override;
+            void draw_point      (const Point2f & position) override;
+            void draw_segment    (const Point2f & a, const Point2f & b) override;
+            void draw_triangle   (const Point2f & a, const Point2f & b, const Point2f & c) override;
+            void fill_triangle   (const Point2f & a, const Point2f & b, const Point2f & c) override;
+            void draw_rectangle  (const Point2f & bottom_left, const Size2f & size) override;
+            void fill_rectangle  (const Point2f & bottom_left, const Size2f & size) override;
+            void fill_rectangle  (const Point2f & where, const Size2f & size, const Texture_2D   * texture, int handling = CENTER) override;
+            void fill_rectangle  (const Point2f & where, const Size2f & size, const Atlas::Slice * slice,   int handling = CENTER) override;
+            void draw_text       (const Point2f & where, const Text_Layout & text_layout, int handling = TOP | LEFT) override;
+
+            using Canvas::draw_sprites;
+
+            void draw_sprites    (const Sprite_Instance * instances, size_t count) override;
+
+        private:
+
+            void begin (Command command, bool is_draw);
+
+            /** Escribe la posición de un recurso en su lista, añadiéndolo si aún no está. */
+            template< typename TYPE >
+            void write_resource (const TYPE * resource, std::vector< const TYPE * > & list)
+            {
+                if (!resource)
+                {
+                    write (no_resource);
+                    return;
+                }
+
+                auto inserted = resource_ids.insert (std::make_pair (static_cast< const void * >(resource), uint32_t(list.size ())));
+
+                if (inserted.second) list.push_back (resource);
+
+                write (inserted.first->second);
+            }
+
+            template< typename TYPE >
+            void write (const TYPE & value)
+            {
+                size_t offset = commands.size ();
+
+                commands.resize (offset + sizeof(TYPE));
+
+                std::memcpy (commands.data () + offset, &value, sizeof(TYPE));
+            }
+
+        };
+
+    }
+
+#endif
@@ -24,6 +24,14 @@
             Renderer() = default;
             virtual ~Renderer() = default;
 
+        public:
+
+            /**
+             * Envía a la GPU las operaciones de dibujado que el renderer pudiese tener pendientes.
+             * El contexto gráfico lo llama antes de presentar cada fotograma.
+             */
+            virtual void flush () { }
+
         };
 
     }
@@ -0,0 +1,148 @@
+/*
+ * SOFTWARE CANVAS
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610171600
+ */
+
+#ifndef BASICS_SOFTWARE_CANVAS_HEADER
+#define BASICS_SOFTWARE_CANVAS_HEADER
+
+    #include <vector>
+    #include <basics/Canvas>
+    #include <basics/Color_Buffer>
+
+    namespace basics
+    {
+
+        class Memory_Texture_2D;
+
+        /**
+         * Canvas que rasteriza por CPU sobre un Color_Buffer< Rgba8888 >. Dibuja quads con textura
+         * (Texture_2D y Atlas::Slice) con transparencia (respetando el alfa premultiplicado) y muestreo
+         * del texel más cercano, así como las primitivas sin textura. La mezcla de cada span, con
+         * cualquiera de los modos de Blending, usa SSE2 o NEON cuando están disponibles; el muestreo
+         * de las texturas se hace texel a texel.
+         * Permite renderizar escenas en máquinas sin GPU para medir la tasa de relleno (píxeles
+         * escritos) y el overdraw de cada fotograma.
+         * Solo dibuja texturas creadas como Memory_Texture_2D. La fila 0 del buffer es la superior.
+         */
+        class Software_Canvas : public Canvas
+        {
+        public:
+
+            struct Statistics
+            {
+                size_t frames;
+                size_t draws;
+                size_t pixels;                  ///< Píxeles escritos (tasa de relleno).
+
+                /** Veces que, en promedio, se ha escrito cada píxel del buffer. */
+                float overdraw (size_t buffer_size) const
+                {
+                    return buffer_size && frames ? float(pixels) / float(buffer_size * frames) : 0.f;
+                }
+            };
+
+            typedef Color_Buffer< Rgba8888 > Buffer;
+
+        public:
+
+            static Canvas * create (Id id, Graphics_Context::Accessor & context, const Options & options);
+
+            static void enable (Id context_id = ID(software))
+            {
+                register_factory (context_id, Software_Canvas::create);
+            }
+
+        private:
+
+            Buffer           color_buffer;
+            Transformation2f transform;
+            Rgba8888         clear_color;
+            float            color[3];
+            float            opacity;
+            Blending         blending;
+
+            std::vector< Rgba8888 > span;       ///< Píxeles de origen del span que se está mezclando.
+
+            Statistics       frame;
+            Statistics       last_frame;
+
+        public:
+
+            Software_Canvas(const Size2u & size);
+
+        public:
+
+            const Buffer & get_color_buffer () const
+            {
+                return color_buffer;
+            }
+
+            /** Estadísticas del último fotograma terminado (lo termina flush()). */
+            const Statistics & get_last_frame_statistics () const
+            {
+                return last_frame;
+            }
+
+        public:
+
+            void reset_state     () override;
+            void flush           () override;
+
+        public:
+
+            void set_size        (const Size2u & size) override;
+
+        public:
+
+            void set_clear_color (float r, float g, float b) override;
+            void set_color       (float r, float g, float b) override;
+            void set_opacity     (float opacity) override;
+            void set_blending    (Blending blending) override;
+            void set_transform   (const Transformation2f & transform) override;
+            void apply_transform (const Transformation2f & transform) override;
+
+            float get_opacity    () const override
+            {
+                return opacity;
+            }
+
+        public:
+
+            void clear           () override;
+            void draw_point      (const Point2f & position) override;
+            void draw_segment    (const Point2f & a, const Point2f & b) override;
+            void draw_triangle   (const Point2f & a, const Point2f & b, const Point2f & c) override;
+            void fill_triangle   (const Point2f & a, const Point2f & b, const Point2f & c) override;
+            void draw_rectangle  (const Point2f & bottom_left, const Size2f & size) override;
+            void fill_rectangle  (const Point2f & bottom_left, const Size2f & size) override;
+            void fill_rectangle  (const Point2f & where, const Size2f & size, const Texture_2D   * texture, int handling = CENTER) override;
+            void fill_rectangle  (const Point2f & where, const Size2f & size, const Atlas::Slice * slice,   int handling = CENTER) override;
+
+        private:
+
+            Point2f  to_pixels     (const Point2f & point) const;
+            Rgba8888 get_color     () const;
+
+            void fill_polygon      (const Point2f & origin, const Point2f & s_end, const Point2f & t_end, bool triangle);
+            void fill_textured_quad
+            (
+                const Memory_Texture_2D * texture,
+                const Point2f           & bottom_left,
+                const Size2f            & size,
+                const Point2f           * texture_uvs
+            );
+            void blend_pixels      (Rgba8888 * target, const Rgba8888 * source, size_t count, bool premultiplied = false);
+
+        };
+
+    }
+
+#endif
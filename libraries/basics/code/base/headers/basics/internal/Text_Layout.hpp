@@ -43,16 +43,37 @@
 
         private:
 
-            Glyph_List glyphs;
-            float      width;
-            float      height;
+            Glyph_List          glyphs;
+            float               width;
+            float               height;
+            uint32_t            font_serial;                ///< Serial de la fuente con la que se distribuyó text (0 si ninguna).
+            std::wstring        text;                       ///< Texto distribuido en glyphs.
 
         public:
 
+            /** Crea una distribución vacía que se rellena después con assign() o assign_number(). */
+            Text_Layout();
+
             Text_Layout(const Raster_Font & font, const std::wstring & text);
 
         public:
 
+            /**
+             * Distribuye otro texto reutilizando la memoria de los glifos, por lo que solo se reserva
+             * memoria si el texto nuevo tiene más caracteres que los anteriores.
+             * Si la fuente y el texto son los mismos que la última vez no se hace nada. La fuente se
+             * identifica por su serial, no por su dirección, para no reutilizar los slices de una
+             * fuente destruida si otra se crea en la misma dirección.
+             */
+            void assign (const Raster_Font & font, const std::wstring & text);
+
+            /**
+             * Distribuye los dígitos de un número sin reservar memoria en el heap (salvo la primera vez
+             * o si tiene más dígitos que los anteriores). Pensado para marcadores y contadores que se
+             * dibujan en cada fotograma: los glifos solo se recalculan cuando cambia el valor.
+             */
+            void assign_number (const Raster_Font & font, int number);
+
             const Glyph_List & get_glyphs () const
             {
                 return glyphs;
@@ -68,6 +89,10 @@
                 return height;
             }
 
+        private:
+
+            void assign (const Raster_Font & font, const wchar_t * begin, const wchar_t * end);
+
         };
 
     }
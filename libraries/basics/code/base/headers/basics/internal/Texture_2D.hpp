@@ -15,6 +15,7 @@
 
     #include <memory>
     #include <string>
+    #include <vector>
     #include <basics/Asset>
     #include <basics/Color_Buffer>
     #include <basics/Graphics_Context>
@@ -27,47 +28,138 @@
         {
         public:
 
+            /**
+             * Formato en el que se guardan los píxeles en la GPU. Los de menor precisión ocupan la mitad
+             * (RGB565, RGBA4444) o la cuarta parte (A8) de memoria. RGB565 descarta el alfa, por lo
+             * que solo se aplica si la imagen es opaca (las que tienen transparencia se guardan como
+             * RGBA8888). A8 descarta el color: al dibujarla se usa el color del canvas (set_color()).
+             */
+            enum Format
+            {
+                RGBA8888,
+                RGB565,
+                RGBA4444,
+                A8,
+            };
+
+            enum Filter
+            {
+                LINEAR,
+                NEAREST,
+            };
+
+            /**
+             * Todos los campos tienen un valor por defecto, por lo que basta con asignar por su nombre
+             * los que se quieren cambiar.
+             */
             struct Options
             {
-                unsigned width;
-                unsigned height;
+                unsigned width         = 0;
+                unsigned height        = 0;
+                bool     opaque        = false;     ///< Todos los píxeles tienen alfa 255.
+                Format   format        = RGBA8888;
+                bool     dither        = false;     ///< Aplicar tramado al convertir a RGB565 o RGBA4444.
+                Filter   filter        = LINEAR;
+                bool     mipmaps       = false;     ///< Generar mipmaps (filtrado trilineal al reducir la textura).
+                bool     premultiplied = false;     ///< Multiplicar el color por el alfa al cargar la imagen.
+                bool     staged        = false;     ///< Subir la imagen por franjas en varios fotogramas (ver is_ready()).
+
+                // El constructor se declara explícitamente para poder usar Options() como argumento por
+                // defecto dentro de Texture_2D (el implícito necesitaría la clase ya completa):
+
+                Options()
+                {
+                }
+            };
+
+            /**
+             * Imagen comprimida en un formato que la GPU puede muestrear directamente.
+             */
+            struct Compressed_Image
+            {
+                enum Format
+                {
+                    ETC1_RGB8,
+                };
+
+                Format              format;
+                unsigned            width;
+                unsigned            height;
+                std::vector< byte > data;
             };
 
         public:
 
-            typedef std::shared_ptr< Texture_2D > (* Factory) (Id id, Color_Buffer< Rgba8888 > & color_buffer, const Options & options);
+            typedef std::shared_ptr< Texture_2D > (* Factory           ) (Id id, Color_Buffer< Rgba8888 > & color_buffer, const Options & options);
+            typedef std::shared_ptr< Texture_2D > (* Compressed_Factory) (Id id, Compressed_Image & compressed_image, const Options & options);
 
         private:
 
-            static Id      texture_2d_specialization_ids      [10];
-            static Factory texture_2d_specialization_factories[10];
-            static size_t  texture_2d_specialization_count;
+            static Id                 texture_2d_specialization_ids                 [10];
+            static Factory            texture_2d_specialization_factories           [10];
+            static Compressed_Factory texture_2d_specialization_compressed_factories[10];
+            static size_t             texture_2d_specialization_count;
 
         public:
 
-            static void register_factory (Id id, Factory factory)
+            static void register_factory (Id id, Factory factory, Compressed_Factory compressed_factory = nullptr)
             {
-                texture_2d_specialization_ids      [texture_2d_specialization_count] = id;
-                texture_2d_specialization_factories[texture_2d_specialization_count] = factory;
+                texture_2d_specialization_ids                 [texture_2d_specialization_count] = id;
+                texture_2d_specialization_factories           [texture_2d_specialization_count] = factory;
+                texture_2d_specialization_compressed_factories[texture_2d_specialization_count] = compressed_factory;
                 texture_2d_specialization_count++;
             }
 
+            /**
+             * Descomprime una imagen en la CPU. Se usa con los contextos que no admiten su formato.
+             */
+            static bool decompress (const Compressed_Image & compressed_image, Color_Buffer< Rgba8888 > & color_buffer);
+
         public:
 
+            /**
+             * Crea una textura con el contexto indicado. La textura se queda con los píxeles de
+             * color_buffer o con los datos de compressed_image sin copiarlos, por lo que pueden quedar
+             * vacíos.
+             */
             static std::shared_ptr< Texture_2D > create (Id id, Graphics_Context::Accessor & context, Color_Buffer< Rgba8888 > & color_buffer, const Options & options = {});
+            static std::shared_ptr< Texture_2D > create (Id id, Graphics_Context::Accessor & context, Compressed_Image & compressed_image, const Options & options = {});
             static std::shared_ptr< Texture_2D > create (Id id, Graphics_Context::Accessor & context, const std::string & asset_path, const Options & options = {});
 
+            /**
+             * Lee y decodifica la imagen de un asset sin crear la textura, por lo que se puede llamar
+             * desde cualquier hilo. Si la ruta termina en .png y junto a ella existe una versión en
+             * bruto (ver raw_texture), se carga esta última sin decodificar el PNG. Si esa versión está
+             * comprimida, los datos se dejan en compressed_image y color_buffer queda vacío.
+             * @param options A la salida contiene las dimensiones y la opacidad de la imagen y si sus
+             *     píxeles tienen el alfa premultiplicado (también si ya lo estaban). El resto de campos
+             *     quedan con sus valores por defecto.
+             * @param premultiply Premultiplicar el alfa de la imagen decodificada.
+             */
+            static bool load
+            (
+                const std::string        & asset_path,
+                Color_Buffer< Rgba8888 > & color_buffer,
+                Compressed_Image         & compressed_image,
+                Options                  & options,
+                bool                       premultiply = false
+            );
+
         protected:
 
             float width;
             float height;
+            bool  opaque;
+            bool  premultiplied;
 
         protected:
 
-            Texture_2D(unsigned width, unsigned height)
+            Texture_2D(unsigned width, unsigned height, bool opaque = false, bool premultiplied = false)
             :
-                width (float(width )),
-                height(float(height))
+                width        (float(width )),
+                height       (float(height)),
+                opaque       (opaque       ),
+                premultiplied(premultiplied)
             {
             }
 
@@ -87,6 +179,31 @@
                 return height;
             }
 
+            /**
+             * Indica si la textura no tiene ningún píxel transparente o translúcido, en cuyo caso se
+             * puede dibujar sin mezclar con lo que haya debajo. Las texturas cargadas desde un PNG lo
+             * detectan al decodificarlo. Las creadas a partir de un Color_Buffer lo toman de Options.
+             */
+            bool is_opaque () const
+            {
+                return opaque;
+            }
+
+            /**
+             * Indica si el color de los píxeles está multiplicado por su alfa, en cuyo caso se debe
+             * mezclar con GL_ONE en lugar de con GL_SRC_ALPHA.
+             */
+            bool is_premultiplied () const
+            {
+                return premultiplied;
+            }
+
+            /** Bytes aproximados que ocupan los píxeles de la textura. */
+            virtual size_t get_memory_size () const
+            {
+                return size_t(width) * size_t(height) * 4;
+            }
+
         };
 
     }
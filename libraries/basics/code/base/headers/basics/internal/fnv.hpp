@@ -125,6 +125,19 @@
             return hash;
         }
 
+        inline uint32_t fnv32 (const byte * data, size_t size)
+        {
+            uint32_t hash = internal::fnv_basis_32;
+
+            for (const byte * end = data + size; data < end; ++data)
+            {
+                hash ^= *data;
+                hash *= internal::fnv_prime_32;
+            }
+
+            return hash;
+        }
+
     }
 
     constexpr unsigned operator "" _fnv (const char * c)
@@ -0,0 +1,61 @@
+/*
+ * PIXEL CONVERSION
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610172230
+ */
+
+#ifndef BASICS_PIXEL_CONVERSION_HEADER
+#define BASICS_PIXEL_CONVERSION_HEADER
+
+    #include <vector>
+    #include <basics/Color_Buffer>
+
+    namespace basics
+    {
+
+        /**
+         * Convierte una imagen RGBA8888 a formatos de menor precisión que ocupan la mitad (RGB565 y
+         * RGBA4444) o la cuarta parte (A8) de memoria. Los píxeles de 16 bits se empaquetan como los
+         * espera glTexImage2D con GL_UNSIGNED_SHORT_5_6_5 y GL_UNSIGNED_SHORT_4_4_4_4.
+         * Con dither se aplica un tramado ordenado (matriz de Bayer de 4x4) que reparte el error de
+         * cuantización y evita las bandas en los degradados.
+         */
+
+        void convert_to_rgb565   (const Color_Buffer< Rgba8888 > & source, std::vector< uint16_t > & target, bool dither = false);
+        void convert_to_rgba4444 (const Color_Buffer< Rgba8888 > & source, std::vector< uint16_t > & target, bool dither = false);
+
+        /** Conserva solo el canal alfa. */
+        void convert_to_a8       (const Color_Buffer< Rgba8888 > & source, std::vector< uint8_t  > & target);
+
+        /**
+         * Como las anteriores, pero convierten width x height píxeles consecutivos (por ejemplo una
+         * franja de filas de un Color_Buffer) sin necesidad de copiarlos antes a otro buffer.
+         */
+
+        void convert_to_rgb565   (const Rgba8888 * source, unsigned width, unsigned height, std::vector< uint16_t > & target, bool dither = false);
+        void convert_to_rgba4444 (const Rgba8888 * source, unsigned width, unsigned height, std::vector< uint16_t > & target, bool dither = false);
+        void convert_to_a8       (const Rgba8888 * source, unsigned width, unsigned height, std::vector< uint8_t  > & target);
+
+        /**
+         * Reduce una imagen a la mitad de ancho y de alto (como mínimo 1) promediando cada bloque de
+         * 2x2 píxeles. Sirve para generar cada nivel de una cadena de mipmaps a partir del anterior.
+         * Si alguna dimensión es impar, la última fila o columna se promedia consigo misma.
+         */
+        void downsample_2x2      (const Color_Buffer< Rgba8888 > & source, Color_Buffer< Rgba8888 > & target);
+
+        /**
+         * Multiplica el color de cada píxel por su alfa, redondeando al valor más cercano. Las texturas
+         * con alfa premultiplicado no oscurecen los bordes al filtrarlas ni al reducirlas a mipmaps,
+         * y se mezclan con GL_ONE, GL_ONE_MINUS_SRC_ALPHA.
+         */
+        void premultiply_alpha   (Color_Buffer< Rgba8888 > & color_buffer);
+
+    }
+
+#endif
@@ -0,0 +1,106 @@
+/*
+ *  RAW ATLAS
+ *  Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ *  Distributed under the Boost Software License, version  1.0
+ *  See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ *  angel.rodriguez@esne.edu
+ *
+ *  C2610181010
+ */
+
+#ifndef BASICS_RAW_ATLAS_HEADER
+#define BASICS_RAW_ATLAS_HEADER
+
+    #include <cstdint>
+    #include <string>
+    #include <vector>
+    #include <basics/fnv>
+    #include <basics/types>
+
+    namespace basics
+    {
+
+        /**
+         * Slice de un atlas en bruto. El id es el hash fnv32 del nombre completo del slice (con los
+         * nombres de sus "dir" separados por puntos), igual que el que calcula Atlas al leer el XML.
+         * Las coordenadas están en píxeles, como en el .sprites.
+         */
+        struct Raw_Atlas_Slice
+        {
+            uint32_t id;
+            uint16_t x;
+            uint16_t y;
+            uint16_t width;
+            uint16_t height;
+        };
+
+        static_assert(sizeof(Raw_Atlas_Slice) == 12, "Raw_Atlas_Slice must not have padding.");
+
+        /**
+         * Versión precompilada de un .sprites: una cabecera de tamaño fijo seguida de los slices
+         * ordenados por id y del nombre del archivo de la textura (relativo al del atlas y sin nulo
+         * final). Los slices se pueden usar directamente desde el buffer del archivo, sin parsear.
+         * Los archivos se generan con la herramienta tools/raw_atlas_converter y se guardan junto al
+         * .sprites con la extensión raw_atlas_extension. La cabecera guarda el hash del .sprites para
+         * detectar si este ha cambiado después. Todos los campos se guardan en little endian.
+         */
+        struct Raw_Atlas_Header
+        {
+            char     magic[4];                      ///< "BATL"
+            uint16_t version;
+            uint16_t name_size;                     ///< Bytes del nombre de la textura.
+            uint32_t slice_count;
+            uint32_t source_hash;                   ///< fnv32 del contenido del .sprites.
+        };
+
+        static_assert(sizeof(Raw_Atlas_Header) == 16, "Raw_Atlas_Header must not have padding.");
+
+        extern const char raw_atlas_extension[];    ///< ".batl"
+
+        /**
+         * Comprueba la cabecera de un archivo de atlas en bruto.
+         * @return Un puntero a la cabecera dentro de encoded_data o nullptr si no es válida o si los
+         *     datos están truncados.
+         */
+        const Raw_Atlas_Header * raw_atlas_header (const std::vector< byte > & encoded_data);
+
+        /** Retorna el primero de los header->slice_count slices que siguen a una cabecera válida. */
+        inline const Raw_Atlas_Slice * raw_atlas_slices (const Raw_Atlas_Header * header)
+        {
+            return reinterpret_cast< const Raw_Atlas_Slice * >(header + 1);
+        }
+
+        /** Retorna el nombre del archivo de la textura que sigue a los slices de una cabecera válida. */
+        inline std::string raw_atlas_texture_name (const Raw_Atlas_Header * header)
+        {
+            const char * name = reinterpret_cast< const char * >(raw_atlas_slices (header) + header->slice_count);
+
+            return std::string(name, header->name_size);
+        }
+
+        /**
+         * Indica si un atlas en bruto se generó a partir del contenido actual de su .sprites.
+         */
+        inline bool raw_atlas_matches (const Raw_Atlas_Header * header, const std::vector< byte > & source_data)
+        {
+            return header->source_hash == fnv32 (source_data.data (), source_data.size ());
+        }
+
+        /**
+         * Guarda un atlas en bruto. Los slices se ordenan por id.
+         * @param source_hash fnv32 del contenido del .sprites del que se genera.
+         * @return false si hay dos slices con el mismo id (colisión del hash o nombre repetido).
+         */
+        bool raw_atlas_encode
+        (
+            const std::string              & texture_name,
+            uint32_t                         source_hash,
+            std::vector< Raw_Atlas_Slice >   slices,
+            std::vector< byte >            & encoded_data
+        );
+
+    }
+
+#endif
@@ -0,0 +1,122 @@
+/*
+ *  RAW FONT
+ *  Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ *  Distributed under the Boost Software License, version  1.0
+ *  See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ *  angel.rodriguez@esne.edu
+ *
+ *  C2610181020
+ */
+
+#ifndef BASICS_RAW_FONT_HEADER
+#define BASICS_RAW_FONT_HEADER
+
+    #include <cstdint>
+    #include <string>
+    #include <vector>
+    #include <basics/fnv>
+    #include <basics/types>
+
+    namespace basics
+    {
+
+        /**
+         * Carácter de una fuente en bruto con los mismos datos que el tag "char" de BMFont.
+         */
+        struct Raw_Font_Glyph
+        {
+            uint32_t code;                          ///< Código Unicode.
+            uint16_t x;
+            uint16_t y;
+            uint16_t width;
+            uint16_t height;
+            int16_t  x_offset;
+            int16_t  y_offset;
+            int16_t  advance;
+            uint16_t reserved;
+        };
+
+        static_assert(sizeof(Raw_Font_Glyph) == 20, "Raw_Font_Glyph must not have padding.");
+
+        /**
+         * Versión precompilada de una fuente BMFont (.fnt en XML con una única página): una cabecera
+         * de tamaño fijo seguida de los caracteres ordenados por código, del nombre de la fuente y
+         * del nombre del archivo de la textura (relativo al de la fuente). Los nombres no tienen
+         * nulo final. Los archivos se generan con la herramienta tools/raw_font_converter y se
+         * guardan junto al .fnt con la extensión raw_font_extension. La cabecera guarda el hash del
+         * .fnt para detectar si este ha cambiado después. Todos los campos se guardan en little
+         * endian.
+         */
+        struct Raw_Font_Header
+        {
+            char     magic[4];                      ///< "BFNT"
+            uint16_t version;
+            uint16_t line_height;
+            uint16_t base;                          ///< Distancia desde la parte superior de la línea hasta la base.
+            uint16_t face_size;                     ///< Bytes del nombre de la fuente.
+            uint16_t name_size;                     ///< Bytes del nombre de la textura.
+            uint16_t reserved;
+            uint32_t glyph_count;
+            uint32_t source_hash;                   ///< fnv32 del contenido del .fnt.
+        };
+
+        static_assert(sizeof(Raw_Font_Header) == 24, "Raw_Font_Header must not have padding.");
+
+        extern const char raw_font_extension[];     ///< ".bfnt"
+
+        /**
+         * Comprueba la cabecera de un archivo de fuente en bruto.
+         * @return Un puntero a la cabecera dentro de encoded_data o nullptr si no es válida o si los
+         *     datos están truncados.
+         */
+        const Raw_Font_Header * raw_font_header (const std::vector< byte > & encoded_data);
+
+        /** Retorna el primero de los header->glyph_count caracteres que siguen a una cabecera válida. */
+        inline const Raw_Font_Glyph * raw_font_glyphs (const Raw_Font_Header * header)
+        {
+            return reinterpret_cast< const Raw_Font_Glyph * >(header + 1);
+        }
+
+        inline std::string raw_font_face (const Raw_Font_Header * header)
+        {
+            const char * face = reinterpret_cast< const char * >(raw_font_glyphs (header) + header->glyph_count);
+
+            return std::string(face, header->face_size);
+        }
+
+        inline std::string raw_font_texture_name (const Raw_Font_Header * header)
+        {
+            const char * name = reinterpret_cast< const char * >(raw_font_glyphs (header) + header->glyph_count) + header->face_size;
+
+            return std::string(name, header->name_size);
+        }
+
+        /**
+         * Indica si una fuente en bruto se generó a partir del contenido actual de su .fnt.
+         */
+        inline bool raw_font_matches (const Raw_Font_Header * header, const std::vector< byte > & source_data)
+        {
+            return header->source_hash == fnv32 (source_data.data (), source_data.size ());
+        }
+
+        /**
+         * Guarda una fuente en bruto. Los caracteres se ordenan por código.
+         * @param source_hash fnv32 del contenido del .fnt del que se genera.
+         * @return false si hay dos caracteres con el mismo código.
+         */
+        bool raw_font_encode
+        (
+            const std::string             & face,
+            const std::string             & texture_name,
+            unsigned                        line_height,
+            unsigned                        base,
+            uint32_t                        source_hash,
+            std::vector< Raw_Font_Glyph >   glyphs,
+            std::vector< byte >           & encoded_data
+        );
+
+    }
+
+#endif
@@ -0,0 +1,249 @@
+/*
+ * ASSET CACHE
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610181000
+ */
+
+#include <basics/Asset_Cache>
+
+using namespace std;
+
+namespace basics
+{
+
+    Asset_Cache & Asset_Cache::get_instance ()
+    {
+        static Asset_Cache instance;
+
+        return instance;
+    }
+
+    Asset_Cache::Asset_Cache()
+    :
+        budget       (32 * 1024 * 1024),
+        resident_size(0)
+    {
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    shared_ptr< Texture_2D > Asset_Cache::get_texture (Graphics_Context::Accessor & context, const string & path, const Texture_2D::Options & options)
+    {
+        Entry & entry = touch (key_of (path, options));
+
+        if (!entry.texture)
+        {
+            entry.texture = Texture_2D::create (0, context, path, options);
+
+            if (entry.texture) context->add (entry.texture);
+
+            measure (entry);
+        }
+
+        // El puntero se entrega antes de liberar otros assets para que este cuente como en uso:
+
+        shared_ptr< Texture_2D > texture = lend (entry.texture, entry);
+
+        evict (context, budget);
+
+        return texture;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    shared_ptr< Atlas > Asset_Cache::get_atlas (Graphics_Context::Accessor & context, const string & path, const Texture_2D::Options & options)
+    {
+        Entry & entry = touch (key_of (path, options));
+
+        if (!entry.atlas)
+        {
+            shared_ptr< Atlas > atlas(new Atlas(path, context, options));
+
+            if (!atlas->good ())
+            {
+                if (atlas->get_texture ()) context->remove (atlas->get_texture ());
+
+                atlas.reset ();
+            }
+
+            entry.atlas = atlas;
+
+            measure (entry);
+        }
+
+        shared_ptr< Atlas > atlas = lend (entry.atlas, entry);
+
+        evict (context, budget);
+
+        return atlas;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    shared_ptr< Raster_Font > Asset_Cache::get_font (Graphics_Context::Accessor & context, const string & path)
+    {
+        Entry & entry = touch (key_of (path, Texture_2D::Options()));
+
+        if (!entry.font)
+        {
+            shared_ptr< Raster_Font > font(new Raster_Font(path, context));
+
+            if (!font->good ())
+            {
+                if (font->get_atlas ()) context->remove (font->get_atlas ()->get_texture ());
+
+                font.reset ();
+            }
+
+            entry.font = font;
+
+            measure (entry);
+        }
+
+        shared_ptr< Raster_Font > font = lend (entry.font, entry);
+
+        evict (context, budget);
+
+        return font;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    bool Asset_Cache::contains (const string & path) const
+    {
+        // Como '\0' es el menor de los caracteres, si hay claves con la ruta, la primera que no es
+        // menor que la ruta es una de ellas:
+
+        auto entry = entries.lower_bound (path);
+
+        return
+            entry != entries.end ()                           &&
+            entry->first.size    () >  path.size ()           &&
+            entry->first.compare (0, path.size (), path) == 0 &&
+            entry->first[path.size ()] == '\0';
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    vector< string > Asset_Cache::missing (const vector< string > & paths) const
+    {
+        vector< string > result;
+
+        for (const string & path : paths)
+        {
+            if (!contains (path)) result.push_back (path);
+        }
+
+        return result;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Asset_Cache::trim (Graphics_Context::Accessor & context)
+    {
+        evict (context, budget);
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Asset_Cache::clear (Graphics_Context::Accessor & context)
+    {
+        evict (context, 0);
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    string Asset_Cache::key_of (const string & path, const Texture_2D::Options & options)
+    {
+        const char settings[] =
+        {
+            '\0',
+            char(options.format       ),
+            char(options.dither       ),
+            char(options.filter       ),
+            char(options.mipmaps      ),
+            char(options.premultiplied),
+            char(options.staged       ),
+        };
+
+        return path + string(settings, sizeof(settings));
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    Asset_Cache::Entry & Asset_Cache::touch (const string & key)
+    {
+        auto found = entries.find (key);
+
+        // La clave pedida pasa a ser la más reciente:
+
+        if (found != entries.end ())
+        {
+            usage.splice (usage.begin (), usage, found->second.usage);
+
+            return found->second;
+        }
+
+        usage.push_front (key);
+
+        Entry & entry = entries[key];
+
+        entry.size  = 0;
+        entry.usage = usage.begin ();
+
+        return entry;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Asset_Cache::measure (Entry & entry)
+    {
+        size_t size = 0;
+
+        if (entry.texture) size += entry.texture->get_memory_size ();
+        if (entry.atlas  ) size += entry.atlas->get_texture ()->get_memory_size ();
+        if (entry.font   ) size += entry.font->get_atlas ()->get_texture ()->get_memory_size ();
+
+        resident_size = resident_size - entry.size + size;
+        entry.size    = size;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Asset_Cache::evict (Graphics_Context::Accessor & context, size_t limit)
+    {
+        // Se recorren las claves desde la que hace más tiempo que no se pide. Las entradas vacías (de
+        // assets que no se pudieron cargar) se quitan siempre:
+
+        for (auto key = usage.end (); key != usage.begin (); )
+        {
+            --key;
+
+            auto    found = entries.find (*key);
+            Entry & entry = found->second;
+
+            bool empty = !entry.texture && !entry.atlas && !entry.font;
+
+            if (!empty && (resident_size <= limit || in_use (entry))) continue;
+
+            // Al quitar las texturas del contexto se destruyen y se libera su memoria:
+
+            if (entry.texture) context->remove (entry.texture);
+            if (entry.atlas  ) context->remove (entry.atlas->get_texture ());
+            if (entry.font   ) context->remove (entry.font->get_atlas ()->get_texture ());
+
+            resident_size -= entry.size;
+
+            entries.erase (found);
+
+            key = usage.erase (key);
+        }
+    }
+
+}
@@ -0,0 +1,340 @@
+/*
+ * ASSET LOADER
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610172030
+ */
+
+#include <algorithm>
+#include <rapidxml.hpp>
+#include <basics/Asset>
+#include <basics/Asset_Loader>
+#include <basics/Texture_2D>
+#include <basics/raw_atlas>
+#include <basics/raw_font>
+
+using namespace std;
+using namespace rapidxml;
+
+namespace basics
+{
+
+    namespace
+    {
+
+        bool ends_with (const string & path, const char * extension)
+        {
+            size_t length = char_traits< char >::length (extension);
+
+            return path.size () >= length && path.compare (path.size () - length, length, extension) == 0;
+        }
+
+        string directory_of (const string & path)
+        {
+            size_t slash     = path.find_last_of ('/' );
+            size_t backslash = path.find_last_of ('\\');
+
+            if (slash     == string::npos) return backslash == string::npos ? string() : path.substr (0, backslash + 1);
+            if (backslash == string::npos) return path.substr (0, slash + 1);
+
+            return path.substr (0, std::max (slash, backslash) + 1);
+        }
+
+        // Busca en el XML de un .sprites o de un .fnt el nombre del archivo de su textura:
+
+        string find_texture_path (const string & path, const Asset_Loader::Buffer & data)
+        {
+            vector< char > text(data.begin (), data.end ());
+
+            text.push_back (0);
+
+            xml_document<> xml;
+
+            xml.parse< 0 > (text.data ());
+
+            xml_attribute<> * attribute = nullptr;
+
+            if (ends_with (path, ".fnt"))
+            {
+                xml_node<> * font_tag  = xml.first_node ("font");
+                xml_node<> * pages_tag = font_tag  ? font_tag ->first_node ("pages") : nullptr;
+                xml_node<> * page_tag  = pages_tag ? pages_tag->first_node ("page" ) : nullptr;
+
+                if (page_tag) attribute = page_tag->first_attribute ("file");
+            }
+            else
+            {
+                xml_node<> * img_tag = xml.first_node ("img");
+
+                if (img_tag) attribute = img_tag->first_attribute ("name");
+            }
+
+            return attribute ? directory_of (path) + attribute->value () : string();
+        }
+
+    }
+
+    Asset_Loader & Asset_Loader::get_instance ()
+    {
+        static Asset_Loader instance;
+
+        return instance;
+    }
+
+    Asset_Loader::Asset_Loader()
+    :
+        exit(false)
+    {
+    }
+
+    Asset_Loader::~Asset_Loader()
+    {
+        {
+            lock_guard< mutex > lock(tasks_mutex);
+
+            exit = true;
+        }
+
+        tasks_condition.notify_all ();
+
+        for (auto & worker : workers) worker.join ();
+    }
+
+    shared_future< bool > Asset_Loader::load (const vector< string > & paths)
+    {
+        shared_ptr< Batch >   batch(new Batch);
+        shared_future< bool > result = batch->done.get_future ().share ();
+
+        // Se cuenta un elemento más que se descuenta al final para que el lote no se pueda completar
+        // mientras todavía se están encolando sus tareas:
+
+        batch->pending = paths.size () + 1;
+        batch->failed  = false;
+
+        start_workers ();
+
+        for (const string & path : paths)
+        {
+            enqueue ([this, path, batch] () { process (path, batch); });
+        }
+
+        finish (batch, true);
+
+        return result;
+    }
+
+    shared_ptr< const Asset_Loader::Buffer > Asset_Loader::find_file (const string & path) const
+    {
+        lock_guard< mutex > lock(store_mutex);
+
+        auto file = files.find (path);
+
+        return file != files.end () ? file->second : nullptr;
+    }
+
+    shared_ptr< const Asset_Loader::Image > Asset_Loader::find_image (const string & path) const
+    {
+        lock_guard< mutex > lock(store_mutex);
+
+        auto image = images.find (path);
+
+        return image != images.end () ? image->second : nullptr;
+    }
+
+    shared_ptr< Asset_Loader::Image > Asset_Loader::take_image (const string & path)
+    {
+        lock_guard< mutex > lock(store_mutex);
+
+        auto image = images.find (path);
+
+        if (image == images.end ()) return nullptr;
+
+        shared_ptr< Image > taken = image->second;
+
+        images.erase (image);
+
+        return taken;
+    }
+
+    void Asset_Loader::clear ()
+    {
+        lock_guard< mutex > lock(store_mutex);
+
+        files .clear ();
+        images.clear ();
+    }
+
+    void Asset_Loader::start_workers ()
+    {
+        // Los hilos se crean con la primera carga. Se deja un núcleo libre para el hilo de la escena:
+
+        if (workers.empty ())
+        {
+            unsigned count = std::max (thread::hardware_concurrency (), 2u) - 1;
+
+            for (unsigned index = 0; index < std::min (count, 4u); ++index)
+            {
+                workers.emplace_back (&Asset_Loader::run_worker, this);
+            }
+        }
+    }
+
+    void Asset_Loader::enqueue (Task task)
+    {
+        {
+            lock_guard< mutex > lock(tasks_mutex);
+
+            tasks.push_back (std::move (task));
+        }
+
+        tasks_condition.notify_one ();
+    }
+
+    void Asset_Loader::run_worker ()
+    {
+        for (;;)
+        {
+            Task task;
+
+            {
+                unique_lock< mutex > lock(tasks_mutex);
+
+                tasks_condition.wait (lock, [this] () { return exit || !tasks.empty (); });
+
+                if (exit) return;
+
+                task = std::move (tasks.front ());
+
+                tasks.pop_front ();
+            }
+
+            task ();
+        }
+    }
+
+    void Asset_Loader::process (const string & path, const shared_ptr< Batch > & batch)
+    {
+        if (ends_with (path, ".png"))
+        {
+            finish (batch, load_image (path));
+            return;
+        }
+
+        shared_ptr< Buffer > data;
+
+        // Si se ha generado la versión en bruto de un .sprites o de un .fnt, se lee esa y el nombre
+        // de la textura se toma de su cabecera. También se lee el XML (si está) para que Atlas y
+        // Raster_Font puedan comprobar sin volver a leerlo que la versión en bruto está al día:
+
+        if (ends_with (path, ".sprites") || ends_with (path, ".fnt"))
+        {
+            bool   atlas    = ends_with (path, ".sprites");
+            string raw_path = path.substr (0, path.find_last_of ('.')) + (atlas ? raw_atlas_extension : raw_font_extension);
+
+            if (load_file (raw_path, data))
+            {
+                shared_ptr< Buffer > source;
+                string               texture_name;
+
+                bool has_source = load_file (path, source);
+
+                if (atlas)
+                {
+                    const Raw_Atlas_Header * header = raw_atlas_header (*data);
+
+                    if (header && (!has_source || raw_atlas_matches (header, *source))) texture_name = raw_atlas_texture_name (header);
+                }
+                else
+                {
+                    const Raw_Font_Header  * header = raw_font_header  (*data);
+
+                    if (header && (!has_source || raw_font_matches  (header, *source))) texture_name = raw_font_texture_name  (header);
+                }
+
+                if (!texture_name.empty ())
+                {
+                    string texture_path = directory_of (path) + texture_name;
+
+                    batch->pending++;
+
+                    enqueue ([this, texture_path, batch] () { process (texture_path, batch); });
+
+                    finish (batch, true);
+                    return;
+                }
+            }
+        }
+
+        if (!load_file (path, data))
+        {
+            finish (batch, false);
+            return;
+        }
+
+        // La textura de un .sprites o de un .fnt se encola como una tarea más del mismo lote para que
+        // se decodifique en paralelo con el resto:
+
+        if (ends_with (path, ".sprites") || ends_with (path, ".fnt"))
+        {
+            string texture_path = find_texture_path (path, *data);
+
+            if (texture_path.empty ())
+            {
+                finish (batch, false);
+                return;
+            }
+
+            batch->pending++;
+
+            enqueue ([this, texture_path, batch] () { process (texture_path, batch); });
+        }
+
+        finish (batch, true);
+    }
+
+    bool Asset_Loader::load_image (const string & path)
+    {
+        if (find_image (path)) return true;
+
+        shared_ptr< Image > image(new Image());
+
+        if (!Texture_2D::load (path, image->color_buffer, image->compressed_image, image->options)) return false;
+
+        lock_guard< mutex > lock(store_mutex);
+
+        images[path] = image;
+
+        return true;
+    }
+
+    bool Asset_Loader::load_file (const string & path, shared_ptr< Buffer > & data)
+    {
+        shared_ptr< Asset > asset = Asset::open (path);
+
+        data.reset (new Buffer);
+
+        if (!asset || !asset->read_all (*data)) return false;
+
+        lock_guard< mutex > lock(store_mutex);
+
+        files[path] = data;
+
+        return true;
+    }
+
+    void Asset_Loader::finish (const shared_ptr< Batch > & batch, bool success)
+    {
+        if (!success) batch->failed = true;
+
+        if (--batch->pending == 0)
+        {
+            batch->done.set_value (!batch->failed);
+        }
+    }
+
+}
@@ -12,7 +12,9 @@
 
 #include <basics/assert>
 #include <basics/Asset>
+#include <basics/Asset_Loader>
 #include <basics/Atlas>
+#include <basics/raw_atlas>
 #include <cstring>
 
 #include <basics/Log>
@@ -23,17 +25,52 @@ using namespace rapidxml;
 namespace basics
 {
 
-    Atlas::Atlas(const string & path, Graphics_Context::Accessor & context)
+    namespace
     {
+
+        string directory_of (const string & path)
+        {
+            size_t slash     = path.find_last_of ('/' );
+            size_t backslash = path.find_last_of ('\\');
+
+            if (slash     == string::npos) return backslash == string::npos ? string() : path.substr (0, backslash + 1);
+            if (backslash == string::npos) return path.substr (0, slash + 1);
+
+            return path.substr (0, std::max (slash, backslash) + 1);
+        }
+
+    }
+
+    Atlas::Atlas(const string & path, Graphics_Context::Accessor & context, const Texture_2D::Options & texture_options)
+    :
+        index_shift(32)
+    {
+        // Se prefiere la versión en bruto del atlas si se ha generado:
+
+        if (load_raw (path, context, texture_options)) return;
+
+        // Si el archivo se ha leído previamente en segundo plano, se parsea una copia de su contenido:
+
+        auto loaded = Asset_Loader::get_instance ().find_file (path);
+
+        if (loaded)
+        {
+            Buffer slices_data(*loaded);
+
+            parse (slices_data, path, context, texture_options);
+
+            return;
+        }
+
         shared_ptr< Asset > slices_file = Asset::open (path);
 
-        if (slices_file->good ())
+        if (slices_file && slices_file->good ())
         {
             Buffer slices_data;
 
             if (slices_file->read_all (slices_data))
             {
-                parse (slices_data, path, context);
+                parse (slices_data, path, context, texture_options);
             }
         }
     }
@@ -42,7 +79,8 @@ namespace basics
 
     Atlas::Atlas(const Texture_Handle & texture)
     :
-        texture(texture)
+        texture    (texture),
+        index_shift(32     )
     {
     }
 
@@ -50,26 +88,153 @@ namespace basics
 
     Atlas::Slice * Atlas::add_slice (Id id, const Point2f & position, const Size2f & size)
     {
-        if (slices.count (id) == 0)
+        if (get_slice (id)) return nullptr;
+
+        // El índice se agranda antes de que quede ocupado más de la mitad:
+
+        if ((slices.size () + 1) * 2 > index.size ()) reserve (std::max< size_t > (slices.size () * 2, 8));
+
+        slices.push_back
+        ({
+            this,
+            position.coordinates.x (), position.coordinates.x () + size.width,
+            position.coordinates.y (), position.coordinates.y () + size.height,
+            size.width,                size.height
+        });
+
+        Slice * slice = &slices.back ();
+        size_t  mask  = index.size () - 1;
+
+        for (size_t position = home_of (id); ; position = (position + 1) & mask)
+        {
+            if (index[position].slice == nullptr)
+            {
+                index[position] = { id, slice };
+                break;
+            }
+        }
+
+        return slice;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Atlas::reserve (size_t slice_count)
+    {
+        size_t capacity = 16;
+
+        while (capacity < slice_count * 2) capacity <<= 1;
+
+        if (capacity > index.size ()) rebuild_index (capacity);
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Atlas::rebuild_index (size_t capacity)
+    {
+        Slice_Index old_index(capacity, Slot{ 0, nullptr });
+
+        old_index.swap (index);
+
+        index_shift = 32;
+
+        for (size_t size = capacity; size > 1; size >>= 1) index_shift--;
+
+        // Se vuelven a colocar las entradas ocupadas del índice anterior:
+
+        size_t mask = capacity - 1;
+
+        for (const Slot & slot : old_index)
         {
-            return &
-            (
-                slices[id] =
-                {
-                    this,
-                    position.coordinates.x (), position.coordinates.x () + size.width,
-                    position.coordinates.y (), position.coordinates.y () + size.height,
-                    size.width,                size.height
-                }
-            );
-        };
+            if (slot.slice == nullptr) continue;
+
+            size_t position = home_of (slot.id);
 
-        return nullptr;
+            while (index[position].slice != nullptr) position = (position + 1) & mask;
+
+            index[position] = slot;
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    bool Atlas::load_raw (const std::string & path, Graphics_Context::Accessor & context, const Texture_2D::Options & texture_options)
+    {
+        static const string sprites_extension(".sprites");
+
+        if (path.size () <= sprites_extension.size () || path.compare (path.size () - sprites_extension.size (), sprites_extension.size (), sprites_extension) != 0)
+        {
+            return false;
+        }
+
+        string raw_path = path.substr (0, path.size () - sprites_extension.size ()) + raw_atlas_extension;
+
+        // Los slices se leen directamente del buffer, por lo que no hace falta copiar el contenido
+        // si Asset_Loader ya lo ha leído:
+
+        Buffer data;
+        auto   loaded = Asset_Loader::get_instance ().find_file (raw_path);
+
+        if (!loaded)
+        {
+            shared_ptr< Asset > raw_asset = Asset::open (raw_path);
+
+            if (!raw_asset || !raw_asset->read_all (data)) return false;
+        }
+
+        const Buffer           & raw_data = loaded ? *loaded : data;
+        const Raw_Atlas_Header * header   = raw_atlas_header (raw_data);
+
+        if (!header) return false;
+
+        // Si el .sprites está disponible y ha cambiado desde que se generó la versión en bruto, esta
+        // tiene slices desactualizados y se usa el XML:
+
+        Buffer source;
+        auto   loaded_source = Asset_Loader::get_instance ().find_file (path);
+
+        if (!loaded_source)
+        {
+            shared_ptr< Asset > source_asset = Asset::open (path);
+
+            if (source_asset && source_asset->good ()) source_asset->read_all (source);
+        }
+
+        const Buffer & source_data = loaded_source ? *loaded_source : source;
+
+        if (!source_data.empty () && !raw_atlas_matches (header, source_data))
+        {
+            log.e (raw_path + " was not generated from the current " + path + ", the XML is used instead");
+            return false;
+        }
+
+        texture = Texture_2D::create (0, context, directory_of (path) + raw_atlas_texture_name (header), texture_options);
+
+        assert(texture);
+
+        // La textura es la misma que indica el XML, así que si falla no se intenta con él:
+
+        if (!texture) return true;
+
+        context->add (texture);
+
+        // Como se conoce el número de slices, el índice se crea una única vez:
+
+        const Raw_Atlas_Slice * raw_slice = raw_atlas_slices (header);
+
+        reserve (header->slice_count);
+
+        for (uint32_t count = 0; count < header->slice_count; ++count, ++raw_slice)
+        {
+            add_slice (raw_slice->id, { float(raw_slice->x), float(raw_slice->y) }, { float(raw_slice->width), float(raw_slice->height) });
+        }
+
+        return true;
     }
 
     // ---------------------------------------------------------------------------------------------
 
-    void Atlas::parse (Buffer & slices_data, const std::string & path, Graphics_Context::Accessor & context)
+    void Atlas::parse (Buffer & slices_data, const std::string & path, Graphics_Context::Accessor & context, const Texture_2D::Options & texture_options)
     {
         // Se pone un caracter nulo al final para que el parseador de rapidxml sepa dónde está el
         // final de los datos:
@@ -88,13 +253,13 @@ namespace basics
 
         if (img_tag)
         {
-            parse_img (img_tag, path, context);
+            parse_img (img_tag, path, context, texture_options);
         }
     }
 
     // ---------------------------------------------------------------------------------------------
 
-    void Atlas::parse_img (rapidxml::xml_node<> * img_tag, const std::string & path, Graphics_Context::Accessor & context)
+    void Atlas::parse_img (rapidxml::xml_node<> * img_tag, const std::string & path, Graphics_Context::Accessor & context, const Texture_2D::Options & texture_options)
     {
         // Se busca el atributo "name" del tag "img", el cual indica el nombre del archivo de la textura:
 
@@ -102,30 +267,9 @@ namespace basics
 
         if (name_attribute)
         {
-            // Se determina la ruta de la textura:
-
-            size_t slash     = path.find_last_of ('/' );
-            size_t backslash = path.find_last_of ('\\');
-            string texture_path;
-
-            if (slash != string::npos && backslash != string::npos)
-            {
-                texture_path = path.substr (0, std::max (slash, backslash + 1));
-            }
-            else
-            if (slash != string::npos)
-            {
-                texture_path = path.substr (0, slash + 1);
-            }
-            else
-            if (backslash != string::npos)
-            {
-                texture_path = path.substr (0, backslash + 1);
-            }
-
-            // Se intenta cargar la textura:
+            // Se intenta cargar la textura, cuya ruta es relativa a la del atlas:
 
-            texture = Texture_2D::create (0, context, texture_path + name_attribute->value ());
+            texture = Texture_2D::create (0, context, directory_of (path) + name_attribute->value (), texture_options);
 
             assert(texture);
 
@@ -0,0 +1,344 @@
+/*
+ * ATLAS PACKER
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610180930
+ */
+
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <cstring>
+#include <basics/Asset_Loader>
+#include <basics/Atlas_Packer>
+#include <basics/pixel_conversion>
+
+namespace basics
+{
+
+    Skyline_Packer::Skyline_Packer(unsigned width, unsigned height)
+    :
+        width      (width ),
+        height     (height),
+        used_height(0),
+        used_area  (0)
+    {
+        // Al principio la página es un único tramo vacío que ocupa todo el ancho:
+
+        skyline.push_back ({ 0, 0, width });
+    }
+
+    bool Skyline_Packer::insert (unsigned rectangle_width, unsigned rectangle_height, unsigned & x, unsigned & y)
+    {
+        if (rectangle_width == 0 || rectangle_height == 0) return false;
+
+        size_t   best_index  = skyline.size ();
+        unsigned best_bottom = UINT_MAX;
+        unsigned best_width  = UINT_MAX;
+        unsigned best_y      = 0;
+
+        // Se prueba a apoyar el rectángulo en el extremo izquierdo de cada tramo. Queda por debajo
+        // del más alto de los tramos sobre los que se extiende:
+
+        for (size_t index = 0; index < skyline.size (); ++index)
+        {
+            unsigned left = skyline[index].x;
+
+            if (left + rectangle_width > width) break;
+
+            unsigned top = 0;
+
+            for (size_t covered = index; covered < skyline.size () && skyline[covered].x < left + rectangle_width; ++covered)
+            {
+                top = std::max (top, skyline[covered].y);
+            }
+
+            unsigned bottom = top + rectangle_height;
+
+            if (bottom > height) continue;
+
+            // Se prefiere el sitio más alto y, a igualdad, el tramo más estrecho (el que deja menos hueco):
+
+            if (bottom < best_bottom || (bottom == best_bottom && skyline[index].width < best_width))
+            {
+                best_index  = index;
+                best_bottom = bottom;
+                best_width  = skyline[index].width;
+                best_y      = top;
+            }
+        }
+
+        if (best_index == skyline.size ()) return false;
+
+        x = skyline[best_index].x;
+        y = best_y;
+
+        // El rectángulo pasa a ser un nuevo tramo y se recortan o eliminan los que quedan debajo:
+
+        unsigned right = x + rectangle_width;
+
+        skyline.insert (skyline.begin () + best_index, Segment{ x, best_bottom, rectangle_width });
+
+        for (size_t index = best_index + 1; index < skyline.size () && skyline[index].x < right; )
+        {
+            Segment & segment = skyline[index];
+            unsigned  end     = segment.x + segment.width;
+
+            if (end <= right)
+            {
+                skyline.erase (skyline.begin () + index);
+            }
+            else
+            {
+                segment.width = end - right;
+                segment.x     = right;
+                break;
+            }
+        }
+
+        // Se juntan los tramos contiguos que han quedado a la misma altura:
+
+        for (size_t index = 0; index + 1 < skyline.size (); )
+        {
+            if (skyline[index].y == skyline[index + 1].y)
+            {
+                skyline[index].width += skyline[index + 1].width;
+                skyline.erase (skyline.begin () + index + 1);
+            }
+            else
+                ++index;
+        }
+
+        used_area  += uint64_t(rectangle_width) * rectangle_height;
+        used_height = std::max (used_height, best_bottom);
+
+        return true;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    Atlas_Packer::Atlas_Packer(const Size2u & page_size, unsigned border)
+    :
+        page_size(page_size),
+        border   (border   )
+    {
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Atlas_Packer::add (Id id, const std::string & asset_path)
+    {
+        entries.push_back ({ id, asset_path, Color_Buffer< Rgba8888 >(), false });
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Atlas_Packer::add (Id id, const Color_Buffer< Rgba8888 > & image, bool premultiplied)
+    {
+        entries.push_back ({ id, std::string(), image, premultiplied });
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    bool Atlas_Packer::pack (Graphics_Context::Accessor & context, const Texture_2D::Options & options)
+    {
+        bool success       = true;
+        bool premultiplied = options.premultiplied;
+
+        // Se leen las imágenes de los assets. Si Asset_Loader ya las ha decodificado se toman sus píxeles:
+
+        for (Entry & entry : entries)
+        {
+            if (entry.path.empty ()) continue;
+
+            Texture_2D::Options          image_options{};
+            Texture_2D::Compressed_Image compressed_image;
+
+            auto loaded = Asset_Loader::get_instance ().take_image (entry.path);
+
+            if (loaded)
+            {
+                entry.image      = std::move (loaded->color_buffer);
+                compressed_image = std::move (loaded->compressed_image);
+                image_options    = loaded->options;
+            }
+            else
+            if (!Texture_2D::load (entry.path, entry.image, compressed_image, image_options))
+            {
+                entry.image.resize (0, 0);
+            }
+
+            // Las páginas se guardan sin comprimir, por lo que los bloques ETC1 se descomprimen:
+
+            if (!compressed_image.data.empty () && !Texture_2D::decompress (compressed_image, entry.image))
+            {
+                entry.image.resize (0, 0);
+            }
+
+            entry.premultiplied = image_options.premultiplied;
+        }
+
+        // Si alguna imagen llega con el alfa premultiplicado (no se puede deshacer sin perder
+        // precisión), se premultiplican todas:
+
+        for (const Entry & entry : entries) premultiplied |= entry.premultiplied;
+
+        // Se colocan de mayor a menor altura y, a igualdad, de mayor a menor anchura:
+
+        std::vector< size_t > order(entries.size ());
+
+        for (size_t index = 0; index < order.size (); ++index) order[index] = index;
+
+        std::stable_sort
+        (
+            order.begin (), order.end (),
+            [this] (size_t a, size_t b)
+            {
+                const Color_Buffer< Rgba8888 > & image_a = entries[a].image;
+                const Color_Buffer< Rgba8888 > & image_b = entries[b].image;
+
+                return image_a.height != image_b.height ? image_a.height > image_b.height : image_a.width > image_b.width;
+            }
+        );
+
+        struct Placement
+        {
+            size_t   page;
+            unsigned x;
+            unsigned y;
+        };
+
+        std::vector< Skyline_Packer > packers;
+        std::vector< Placement      > placements(entries.size (), { SIZE_MAX, 0, 0 });
+
+        for (size_t index : order)
+        {
+            const Color_Buffer< Rgba8888 > & image = entries[index].image;
+
+            if (image.size () == 0)
+            {
+                success = false;
+                continue;
+            }
+
+            unsigned    width     = image.width  + border * 2;
+            unsigned    height    = image.height + border * 2;
+            Placement & placement = placements[index];
+
+            // Se usa la primera página en la que cabe y, si no cabe en ninguna, se abre otra:
+
+            for (size_t page = 0; page < packers.size () && placement.page == SIZE_MAX; ++page)
+            {
+                if (packers[page].insert (width, height, placement.x, placement.y)) placement.page = page;
+            }
+
+            if (placement.page == SIZE_MAX)
+            {
+                packers.emplace_back (page_size.width, page_size.height);
+
+                if (packers.back ().insert (width, height, placement.x, placement.y))
+                {
+                    placement.page = packers.size () - 1;
+                }
+                else
+                {
+                    packers.pop_back ();
+
+                    success = false;            // La imagen es más grande que una página
+                }
+            }
+        }
+
+        // Se copian las imágenes a las páginas y se crean las texturas y los slices:
+
+        for (size_t page = 0; page < packers.size (); ++page)
+        {
+            unsigned page_height = 1;
+
+            while (page_height < packers[page].get_used_height ()) page_height <<= 1;
+
+            Color_Buffer< Rgba8888 > page_buffer(page_size.width, std::min (page_height, page_size.height));
+
+            for (size_t index = 0; index < entries.size (); ++index)
+            {
+                if (placements[index].page != page) continue;
+
+                Entry & entry = entries[index];
+
+                if (premultiplied && !entry.premultiplied) premultiply_alpha (entry.image);
+
+                copy_image (entry.image, page_buffer, placements[index].x, placements[index].y);
+            }
+
+            Texture_2D::Options page_options = options;
+
+            page_options.width         = page_buffer.width;
+            page_options.height        = page_buffer.height;
+            page_options.opaque        = false;
+            page_options.premultiplied = premultiplied;
+
+            std::shared_ptr< Texture_2D > texture = Texture_2D::create (0, context, page_buffer, page_options);
+
+            if (!texture)
+            {
+                success = false;
+                continue;
+            }
+
+            context->add (texture);
+
+            pages.emplace_back (new Atlas(texture));
+
+            Atlas & atlas = *pages.back ();
+
+            for (size_t index = 0; index < entries.size (); ++index)
+            {
+                if (placements[index].page != page) continue;
+
+                const Entry & entry = entries[index];
+
+                const Atlas::Slice * slice = atlas.add_slice
+                (
+                    entry.id,
+                    { float(placements[index].x + border), float(placements[index].y + border) },
+                    { float(entry.image.width), float(entry.image.height) }
+                );
+
+                if (slice) slices[entry.id] = slice;
+            }
+        }
+
+        // Las imágenes ya están en las texturas:
+
+        entries.clear ();
+
+        return success;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Atlas_Packer::copy_image (const Color_Buffer< Rgba8888 > & image, Color_Buffer< Rgba8888 > & page, unsigned x, unsigned y) const
+    {
+        // Cada fila se copia entre los píxeles de su borde izquierdo y derecho repetidos. Las filas
+        // del borde superior e inferior repiten la primera y la última fila de la imagen:
+
+        unsigned width  = image.width;
+        unsigned height = image.height;
+
+        for (unsigned row = 0; row < height + border * 2; ++row)
+        {
+            const Rgba8888 * source = &image.buffer[std::min (row > border ? row - border : 0, height - 1) * width];
+                  Rgba8888 * target = &page .buffer[size_t(y + row) * page.width + x];
+
+            std::fill_n (target,                  border, source[0]        );
+            std::memcpy (target + border, source, width * sizeof(Rgba8888));
+            std::fill_n (target + border + width, border, source[width - 1]);
+        }
+    }
+
+}
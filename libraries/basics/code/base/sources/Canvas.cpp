@@ -36,8 +36,35 @@ namespace basics
 
     void Canvas::draw_text (const Point2f & where, const Text_Layout & text_layout, int handling)
     {
-        const Text_Layout::Glyph_List & glyphs = text_layout.get_glyphs ();
+        Point2f top_left = get_text_top_left (where, text_layout, handling);
 
+        for (auto & glyph : text_layout.get_glyphs ())
+        {
+            fill_rectangle
+            (
+                { top_left[0] + glyph.position[0], top_left[1] + glyph.position[1] },
+                glyph.size,
+                glyph.slice,
+                TOP | LEFT
+            );
+        }
+    }
+
+    void Canvas::draw_sprites (const Sprite_Instance * instances, size_t count)
+    {
+        float opacity = get_opacity ();
+
+        for (const Sprite_Instance * instance = instances, * end = instances + count; instance < end; ++instance)
+        {
+            set_opacity    (instance->opacity);
+            fill_rectangle (instance->position, instance->size, instance->slice, instance->handling);
+        }
+
+        set_opacity (opacity);
+    }
+
+    Point2f Canvas::get_text_top_left (const Point2f & where, const Text_Layout & text_layout, int handling)
+    {
         float width  = text_layout.get_width  ();
         float height = text_layout.get_height ();
         float left   = where[0];
@@ -57,16 +84,7 @@ namespace basics
             default:     break;
         }
 
-        for (auto & glyph : glyphs)
-        {
-            fill_rectangle
-            (
-                { left + glyph.position[0], top + glyph.position[1] },
-                glyph.size,
-                glyph.slice,
-                TOP | LEFT
-            );
-        }
+        return { left, top };
     }
 
 }
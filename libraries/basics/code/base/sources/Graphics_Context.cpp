@@ -12,8 +12,28 @@
 
 #include <basics/Graphics_Context>
 #include <basics/Graphics_Resource_Cache>
+#include <basics/Timer>
 
 namespace basics
 {
 
+    void Graphics_Context::process_uploads (float budget_seconds)
+    {
+        Timer timer;
+
+        // Cada recurso recibe el tiempo que queda. Los que terminan se quitan de la cola:
+
+        while (!pending_uploads.empty ())
+        {
+            float remaining = budget_seconds - timer.get_elapsed_seconds ();
+
+            if (remaining <= 0.f) break;
+
+            if (pending_uploads.front ()->continue_upload (remaining))
+            {
+                pending_uploads.erase (pending_uploads.begin ());
+            }
+        }
+    }
+
 }
@@ -0,0 +1,42 @@
+/*
+ * HEADLESS CONTEXT
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610171525
+ */
+
+#include <basics/enable>
+#include <basics/Headless_Context>
+#include <basics/Memory_Texture_2D>
+#include <basics/Recording_Canvas>
+#include <basics/Software_Canvas>
+
+namespace basics
+{
+
+    Id Headless_Context::default_backend_id = ID(recording);
+
+    bool Headless_Context::create (Window::Accessor & window, Graphics_Resource_Cache * cache)
+    {
+        std::shared_ptr< Graphics_Context > context(new Headless_Context(*window.operator -> (), cache));
+
+        return window->set_graphics_context (context);
+    }
+
+    template< >
+    bool enable< Headless_Context > ()
+    {
+        Recording_Canvas ::enable (ID(recording));
+        Memory_Texture_2D::enable (ID(recording));
+        Software_Canvas  ::enable (ID(software ));
+        Memory_Texture_2D::enable (ID(software ));
+
+        return true;
+    }
+
+}
@@ -0,0 +1,23 @@
+/*
+ * MEMORY TEXTURE 2D
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610171505
+ */
+
+#include <basics/Memory_Texture_2D>
+
+namespace basics
+{
+
+    std::shared_ptr< Texture_2D > Memory_Texture_2D::create (Id /*id*/, Color_Buffer< Rgba8888 > & color_buffer, const Options & options)
+    {
+        return std::shared_ptr< Texture_2D >(new Memory_Texture_2D(std::move (color_buffer), options.width, options.height, options.opaque, options.premultiplied));
+    }
+
+}
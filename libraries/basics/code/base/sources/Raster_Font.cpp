@@ -12,7 +12,10 @@
 
 #include <cstring>
 #include <rapidxml.hpp>
+#include <basics/Asset_Loader>
+#include <basics/Log>
 #include <basics/Raster_Font>
+#include <basics/raw_font>
 
 using namespace std;
 using namespace rapidxml;
@@ -20,11 +23,51 @@ using namespace rapidxml;
 namespace basics
 {
 
+    namespace
+    {
+
+        string directory_of (const string & path)
+        {
+            size_t slash     = path.find_last_of ('/' );
+            size_t backslash = path.find_last_of ('\\');
+
+            if (slash     == string::npos) return backslash == string::npos ? string() : path.substr (0, backslash + 1);
+            if (backslash == string::npos) return path.substr (0, slash + 1);
+
+            return path.substr (0, std::max (slash, backslash) + 1);
+        }
+
+    }
+
+    atomic< uint32_t > Raster_Font::next_serial(1);
+
+    // ---------------------------------------------------------------------------------------------
+
     Raster_Font::Raster_Font(const string & path, Graphics_Context::Accessor & context)
+    :
+        latin_1(),
+        serial (next_serial++)
     {
+        // Se prefiere la versión en bruto de la fuente si se ha generado:
+
+        if (load_raw (path, context)) return;
+
+        // Si el archivo se ha leído previamente en segundo plano, se parsea una copia de su contenido:
+
+        auto loaded = Asset_Loader::get_instance ().find_file (path);
+
+        if (loaded)
+        {
+            Buffer font_data(*loaded);
+
+            ready = parse (font_data, path, context);
+
+            return;
+        }
+
         shared_ptr< Asset > font_file = Asset::open (path);
 
-        if (font_file->good ())
+        if (font_file && font_file->good ())
         {
             Buffer font_data;
 
@@ -37,6 +80,107 @@ namespace basics
 
     // ---------------------------------------------------------------------------------------------
 
+    Raster_Font::Character * Raster_Font::add_character (uint32_t code)
+    {
+        if (code < 256) return &latin_1[code];
+
+        size_t page = code >> 8;
+
+        if (page >= pages.size ()) pages.resize (page + 1);
+
+        if (!pages[page]) pages[page].reset (new Character_Page());
+
+        return &(*pages[page])[code & 255];
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    bool Raster_Font::load_raw (const std::string & path, Graphics_Context::Accessor & context)
+    {
+        static const string fnt_extension(".fnt");
+
+        if (path.size () <= fnt_extension.size () || path.compare (path.size () - fnt_extension.size (), fnt_extension.size (), fnt_extension) != 0)
+        {
+            return false;
+        }
+
+        string raw_path = path.substr (0, path.size () - fnt_extension.size ()) + raw_font_extension;
+
+        // Los caracteres se leen directamente del buffer, por lo que no hace falta copiar el
+        // contenido si Asset_Loader ya lo ha leído:
+
+        Buffer data;
+        auto   loaded = Asset_Loader::get_instance ().find_file (raw_path);
+
+        if (!loaded)
+        {
+            shared_ptr< Asset > raw_asset = Asset::open (raw_path);
+
+            if (!raw_asset || !raw_asset->read_all (data)) return false;
+        }
+
+        const Buffer          & raw_data = loaded ? *loaded : data;
+        const Raw_Font_Header * header   = raw_font_header (raw_data);
+
+        if (!header) return false;
+
+        // Si el .fnt está disponible y ha cambiado desde que se generó la versión en bruto, esta
+        // tiene caracteres desactualizados y se usa el XML:
+
+        Buffer source;
+        auto   loaded_source = Asset_Loader::get_instance ().find_file (path);
+
+        if (!loaded_source)
+        {
+            shared_ptr< Asset > source_asset = Asset::open (path);
+
+            if (source_asset && source_asset->good ()) source_asset->read_all (source);
+        }
+
+        const Buffer & source_data = loaded_source ? *loaded_source : source;
+
+        if (!source_data.empty () && !raw_font_matches (header, source_data))
+        {
+            log.e (raw_path + " was not generated from the current " + path + ", the XML is used instead");
+            return false;
+        }
+
+        // La textura es la misma que indica el XML, así que si falla no se intenta con él:
+
+        auto texture = Texture_2D::create (0, context, directory_of (path) + raw_font_texture_name (header));
+
+        assert(texture);
+
+        if (!texture) return true;
+
+        context->add (texture);
+
+        atlas.reset (new Atlas(texture));
+
+        atlas->reserve (header->glyph_count);
+
+        name                = raw_font_face (header);
+        metrics.line_height = header->line_height;
+        metrics.base_height = float(header->line_height) - header->base;
+
+        const Raw_Font_Glyph * glyph = raw_font_glyphs (header);
+
+        for (uint32_t count = 0; count < header->glyph_count; ++count, ++glyph)
+        {
+            Character * character = add_character (glyph->code);
+
+            character->slice   = atlas->add_slice (Id(glyph->code), { float(glyph->x), float(glyph->y) }, { float(glyph->width), float(glyph->height) });
+            character->offset  = Vector2f{ float(glyph->x_offset), float(glyph->y_offset) };
+            character->advance = float(glyph->advance);
+        }
+
+        ready = header->glyph_count > 0;
+
+        return true;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
     bool Raster_Font::parse
     (
         Buffer                     & font_data,
@@ -109,30 +253,9 @@ namespace basics
 
             if (file_attritube)
             {
-                // Se determina la ruta de la textura:
-
-                size_t slash     = path.find_last_of ('/' );
-                size_t backslash = path.find_last_of ('\\');
-                string texture_path;
-
-                if (slash != string::npos && backslash != string::npos)
-                {
-                    texture_path = path.substr (0, std::max (slash, backslash + 1));
-                }
-                else
-                if (slash != string::npos)
-                {
-                    texture_path = path.substr (0, slash + 1);
-                }
-                else
-                if (backslash != string::npos)
-                {
-                    texture_path = path.substr (0, backslash + 1);
-                }
-
-                // Se intenta cargar la textura:
+                // Se intenta cargar la textura, cuya ruta es relativa a la de la fuente:
 
-                auto texture = Texture_2D::create (0, context, texture_path + file_attritube->value ());
+                auto texture = Texture_2D::create (0, context, directory_of (path) + file_attritube->value ());
 
                 assert(texture);
 
@@ -252,15 +375,15 @@ namespace basics
             int y_offset = std::atoi (y_offset_attribute->value ());
             int advance  = std::atoi ( advance_attribute->value ());
 
-            if (width > 0 && height > 0 && character_map.count (uint32_t(id)) == 0)
+            if (width > 0 && height > 0 && id >= 0 && get_character (uint32_t(id)) == nullptr)
             {
-                Character & character = character_map[uint32_t(id)];
+                Character * character = add_character (uint32_t(id));
 
-                character.slice   = atlas->add_slice (Id(id), { float(x), float(y) }, { float(width), float(height) });
-                character.offset  = Vector2f{ float(x_offset), float(y_offset) };
-                character.advance = float(advance);
+                character->slice   = atlas->add_slice (Id(id), { float(x), float(y) }, { float(width), float(height) });
+                character->offset  = Vector2f{ float(x_offset), float(y_offset) };
+                character->advance = float(advance);
 
-                return true;
+                return character->slice != nullptr;
             };
         }
 
@@ -0,0 +1,567 @@
+/*
+ * RECORDING CANVAS
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610171440
+ */
+
+#include <basics/Recording_Canvas>
+
+namespace basics
+{
+
+    namespace
+    {
+
+        // Lee de forma secuencial los valores escritos por Recording_Canvas::write():
+
+        class Command_Reader
+        {
+
+            const byte * position;
+            const byte * end;
+
+        public:
+
+            Command_Reader(const Recording_Canvas::Command_Buffer & commands)
+            :
+                position(commands.data ()),
+                end     (commands.data () + commands.size ())
+            {
+            }
+
+            bool at_end () const
+            {
+                return position == end;
+            }
+
+            size_t remaining () const
+            {
+                return size_t(end - position);
+            }
+
+            /** Lee un valor. Retorna false sin avanzar si no quedan bytes suficientes. */
+            template< typename TYPE >
+            bool read (TYPE & value)
+            {
+                if (size_t(end - position) < sizeof(TYPE)) return false;
+
+                std::memcpy (&value, position, sizeof(TYPE));
+
+                position += sizeof(TYPE);
+
+                return true;
+            }
+
+            /**
+             * Lee la posición de un recurso y lo busca en su lista. Retorna false si los datos están
+             * truncados o si la posición no está en la lista.
+             */
+            template< typename TYPE >
+            bool read_resource (const std::vector< const TYPE * > & list, const TYPE * & resource)
+            {
+                uint32_t id;
+
+                if (!read (id)) return false;
+
+                if (id == Recording_Canvas::no_resource)
+                {
+                    resource = nullptr;
+                    return true;
+                }
+
+                if (id >= list.size ()) return false;
+
+                resource = list[id];
+
+                return true;
+            }
+
+        };
+
+    }
+
+    const uint32_t Recording_Canvas::no_resource;
+
+    Canvas * Recording_Canvas::create (Id id, Graphics_Context::Accessor & context, const Options & options)
+    {
+        std::shared_ptr< Canvas >  canvas(new Recording_Canvas(options.size));
+
+        context->add (id, canvas);
+
+        return canvas.get ();
+    }
+
+    Recording_Canvas::Recording_Canvas(const Size2u & size)
+    :
+        opacity(1.f)
+    {
+        reset_recording ();
+
+        set_size (size);
+    }
+
+    void Recording_Canvas::reset_recording ()
+    {
+        commands.clear ();
+
+        resources.textures.clear ();
+        resources.slices  .clear ();
+        resource_ids      .clear ();
+
+        total       = {};
+        frame       = {};
+        last_frame  = {};
+        frame_start = 0;
+    }
+
+    void Recording_Canvas::begin (Command command, bool is_draw)
+    {
+        if (is_draw)
+        {
+            total.draws++;
+            frame.draws++;
+        }
+        else
+        {
+            total.state_changes++;
+            frame.state_changes++;
+        }
+
+        write (command);
+    }
+
+    void Recording_Canvas::flush ()
+    {
+        // Cada fotograma termina cuando el contexto gráfico lo presenta:
+
+        write (END_OF_FRAME);
+
+        total.frames++;
+        total.bytes  = commands.size ();
+
+        frame.frames = 1;
+        frame.bytes  = commands.size () - frame_start;
+        last_frame   = frame;
+        frame        = {};
+        frame_start  = commands.size ();
+    }
+
+    void Recording_Canvas::set_size (const Size2u & size)
+    {
+        begin (SET_SIZE, false);
+        write (size);
+    }
+
+    void Recording_Canvas::set_clear_color (float r, float g, float b)
+    {
+        begin (SET_CLEAR_COLOR, false);
+        write (r);
+        write (g);
+        write (b);
+    }
+
+    void Recording_Canvas::set_color (float r, float g, float b)
+    {
+        begin (SET_COLOR, false);
+        write (r);
+        write (g);
+        write (b);
+    }
+
+    void Recording_Canvas::set_opacity (float opacity)
+    {
+        this->opacity = opacity;
+
+        begin (SET_OPACITY, false);
+        write (opacity);
+    }
+
+    void Recording_Canvas::set_blending (Blending blending)
+    {
+        begin (SET_BLENDING, false);
+        write (byte(blending));
+    }
+
+    void Recording_Canvas::set_transform (const Transformation2f & transform)
+    {
+        begin (SET_TRANSFORM, false);
+        write (transform);
+    }
+
+    void Recording_Canvas::apply_transform (const Transformation2f & transform)
+    {
+        begin (APPLY_TRANSFORM, false);
+        write (transform);
+    }
+
+    void Recording_Canvas::set_sorting (bool enabled)
+    {
+        begin (SET_SORTING, false);
+        write (byte(enabled));
+    }
+
+    void Recording_Canvas::set_layer (int layer, float depth)
+    {
+        begin (SET_LAYER, false);
+        write (int32_t(layer));
+        write (depth);
+    }
+
+    void Recording_Canvas::clear ()
+    {
+        begin (CLEAR, true);
+    }
+
+    void Recording_Canvas::draw_point (const Point2f & position)
+    {
+        begin (DRAW_POINT, true);
+        write (position);
+    }
+
+    void Recording_Canvas::draw_segment (const Point2f & a, const Point2f & b)
+    {
+        begin (DRAW_SEGMENT, true);
+        write (a);
+        write (b);
+    }
+
+    void Recording_Canvas::draw_triangle (const Point2f & a, const Point2f & b, const Point2f & c)
+    {
+        begin (DRAW_TRIANGLE, true);
+        write (a);
+        write (b);
+        write (c);
+    }
+
+    void Recording_Canvas::fill_triangle (const Point2f & a, const Point2f & b, const Point2f & c)
+    {
+        begin (FILL_TRIANGLE, true);
+        write (a);
+        write (b);
+        write (c);
+    }
+
+    void Recording_Canvas::draw_rectangle (const Point2f & bottom_left, const Size2f & size)
+    {
+        begin (DRAW_RECTANGLE, true);
+        write (bottom_left);
+        write (size);
+    }
+
+    void Recording_Canvas::fill_rectangle (const Point2f & bottom_left, const Size2f & size)
+    {
+        begin (FILL_RECTANGLE, true);
+        write (bottom_left);
+        write (size);
+    }
+
+    void Recording_Canvas::fill_rectangle (const Point2f & where, const Size2f & size, const Texture_2D * texture, int handling)
+    {
+        begin (FILL_TEXTURED_RECTANGLE, true);
+        write (where);
+        write (size);
+        write_resource (texture, resources.textures);
+        write (int32_t(handling));
+    }
+
+    void Recording_Canvas::fill_rectangle (const Point2f & where, const Size2f & size, const Atlas::Slice * slice, int handling)
+    {
+        begin (FILL_SLICE_RECTANGLE, true);
+        write (where);
+        write (size);
+        write_resource (slice, resources.slices);
+        write (int32_t(handling));
+    }
+
+    void Recording_Canvas::draw_text (const Point2f & where, const Text_Layout & text_layout, int handling)
+    {
+        // El texto se guarda ya resuelto en glifos para no depender del Text_Layout al reproducirlo:
+
+        const Text_Layout::Glyph_List & glyphs = text_layout.get_glyphs ();
+
+        write (DRAW_TEXT);
+        write (get_text_top_left (where, text_layout, handling));
+        write (uint32_t(glyphs.size ()));
+
+        for (auto & glyph : glyphs)
+        {
+            write_resource (glyph.slice, resources.slices);
+            write (glyph.position);
+            write (glyph.size    );
+        }
+
+        total.draws += glyphs.size ();
+        frame.draws += glyphs.size ();
+    }
+
+    void Recording_Canvas::draw_sprites (const Sprite_Instance * instances, size_t count)
+    {
+        // Las instancias se guardan como un único comando para que la reproducción pueda agruparlas
+        // igual que al dibujarlas directamente:
+
+        write (DRAW_SPRITES);
+        write (uint32_t(count));
+
+        for (const Sprite_Instance * instance = instances, * end = instances + count; instance < end; ++instance)
+        {
+            write_resource (instance->slice, resources.slices);
+            write (instance->position);
+            write (instance->size    );
+            write (instance->opacity );
+            write (int32_t(instance->handling));
+        }
+
+        total.draws += count;
+        frame.draws += count;
+    }
+
+    bool Recording_Canvas::replay (const Command_Buffer & commands, const Resource_Table & resources, Canvas & target)
+    {
+        Command_Reader reader(commands);
+
+        // Cada comando se lee completo antes de reproducirlo, de modo que uno truncado no llega a
+        // enviarse con valores incompletos:
+
+        while (!reader.at_end ())
+        {
+            Command command;
+
+            if (!reader.read (command)) return false;
+
+            switch (command)
+            {
+                case SET_SIZE:
+                {
+                    Size2u size;
+
+                    if (!reader.read (size)) return false;
+
+                    target.set_size (size);
+                    break;
+                }
+
+                case SET_CLEAR_COLOR:
+                case SET_COLOR:
+                {
+                    float r, g, b;
+
+                    if (!reader.read (r) || !reader.read (g) || !reader.read (b)) return false;
+
+                    if (command == SET_COLOR) target.set_color (r, g, b); else target.set_clear_color (r, g, b);
+                    break;
+                }
+
+                case SET_OPACITY:
+                {
+                    float opacity;
+
+                    if (!reader.read (opacity)) return false;
+
+                    target.set_opacity (opacity);
+                    break;
+                }
+
+                case SET_BLENDING:
+                {
+                    byte blending;
+
+                    if (!reader.read (blending)) return false;
+
+                    target.set_blending (Blending(blending));
+                    break;
+                }
+
+                case SET_TRANSFORM:
+                case APPLY_TRANSFORM:
+                {
+                    Transformation2f transform;
+
+                    if (!reader.read (transform)) return false;
+
+                    if (command == SET_TRANSFORM) target.set_transform (transform); else target.apply_transform (transform);
+                    break;
+                }
+
+                case SET_SORTING:
+                {
+                    byte enabled;
+
+                    if (!reader.read (enabled)) return false;
+
+                    target.set_sorting (enabled != 0);
+                    break;
+                }
+
+                case SET_LAYER:
+                {
+                    int32_t layer;
+                    float   depth;
+
+                    if (!reader.read (layer) || !reader.read (depth)) return false;
+
+                    target.set_layer (layer, depth);
+                    break;
+                }
+
+                case CLEAR:
+                {
+                    target.clear ();
+                    break;
+                }
+
+                case DRAW_POINT:
+                {
+                    Point2f position;
+
+                    if (!reader.read (position)) return false;
+
+                    target.draw_point (position);
+                    break;
+                }
+
+                case DRAW_SEGMENT:
+                {
+                    Point2f a, b;
+
+                    if (!reader.read (a) || !reader.read (b)) return false;
+
+                    target.draw_segment (a, b);
+                    break;
+                }
+
+                case DRAW_TRIANGLE:
+                case FILL_TRIANGLE:
+                {
+                    Point2f a, b, c;
+
+                    if (!reader.read (a) || !reader.read (b) || !reader.read (c)) return false;
+
+                    if (command == DRAW_TRIANGLE) target.draw_triangle (a, b, c); else target.fill_triangle (a, b, c);
+                    break;
+                }
+
+                case DRAW_RECTANGLE:
+                case FILL_RECTANGLE:
+                {
+                    Point2f bottom_left;
+                    Size2f  size;
+
+                    if (!reader.read (bottom_left) || !reader.read (size)) return false;
+
+                    if (command == DRAW_RECTANGLE) target.draw_rectangle (bottom_left, size); else target.fill_rectangle (bottom_left, size);
+                    break;
+                }
+
+                case FILL_TEXTURED_RECTANGLE:
+                {
+                    Point2f            where;
+                    Size2f             size;
+                    const Texture_2D * texture;
+                    int32_t            handling;
+
+                    if (!reader.read (where) || !reader.read (size) || !reader.read_resource (resources.textures, texture) || !reader.read (handling))
+                    {
+                        return false;
+                    }
+
+                    target.fill_rectangle (where, size, texture, handling);
+                    break;
+                }
+
+                case FILL_SLICE_RECTANGLE:
+                {
+                    Point2f              where;
+                    Size2f               size;
+                    const Atlas::Slice * slice;
+                    int32_t              handling;
+
+                    if (!reader.read (where) || !reader.read (size) || !reader.read_resource (resources.slices, slice) || !reader.read (handling))
+                    {
+                        return false;
+                    }
+
+                    target.fill_rectangle (where, size, slice, handling);
+                    break;
+                }
+
+                case DRAW_TEXT:
+                {
+                    Point2f  top_left;
+                    uint32_t count;
+
+                    if (!reader.read (top_left) || !reader.read (count)) return false;
+
+                    while (count--)
+                    {
+                        const Atlas::Slice * slice;
+                        Point2f              position;
+                        Size2f               size;
+
+                        if (!reader.read_resource (resources.slices, slice) || !reader.read (position) || !reader.read (size)) return false;
+
+                        target.fill_rectangle ({ top_left[0] + position[0], top_left[1] + position[1] }, size, slice, TOP | LEFT);
+                    }
+
+                    break;
+                }
+
+                case DRAW_SPRITES:
+                {
+                    uint32_t count;
+
+                    if (!reader.read (count)) return false;
+
+                    // Se evita reservar memoria para un número de instancias que no cabe en el buffer:
+
+                    const size_t instance_size = sizeof(uint32_t) + sizeof(Point2f) + sizeof(Size2f) + sizeof(float) + sizeof(int32_t);
+
+                    if (count > reader.remaining () / instance_size) return false;
+
+                    std::vector< Sprite_Instance > instances(count);
+
+                    for (Sprite_Instance & instance : instances)
+                    {
+                        int32_t handling;
+
+                        if
+                        (
+                            !reader.read_resource (resources.slices, instance.slice) ||
+                            !reader.read (instance.position) ||
+                            !reader.read (instance.size    ) ||
+                            !reader.read (instance.opacity ) ||
+                            !reader.read (handling)
+                        )
+                        {
+                            return false;
+                        }
+
+                        instance.handling = handling;
+                    }
+
+                    target.draw_sprites (instances);
+                    break;
+                }
+
+                case END_OF_FRAME:
+                {
+                    target.flush ();
+                    break;
+                }
+
+                default:
+                {
+                    return false;
+                }
+            }
+        }
+
+        return true;
+    }
+
+}
@@ -0,0 +1,684 @@
+/*
+ * SOFTWARE CANVAS
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610171630
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <basics/Memory_Texture_2D>
+#include <basics/Software_Canvas>
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+    #include <arm_neon.h>
+    #define BASICS_SOFTWARE_CANVAS_NEON
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define BASICS_SOFTWARE_CANVAS_SSE2
+#endif
+
+namespace basics
+{
+
+    namespace
+    {
+
+        // Mezcla un span de píxeles de origen sobre el destino. La opacidad está en el rango
+        // [0, 256] y el color de origen se escala por el alfa o, si ya está premultiplicado, solo
+        // por la opacidad (como hacen los shaders de Canvas_ES2):
+        //   alpha    = (source.a * opacity) >> 8, llevado a [0, 256]
+        //   factor   = premultiplied ? opacity : alpha
+        //   TRANSPARENCY: target     = min ((source * factor + target * (256 - alpha)) >> 8, 255)
+        //   ADD:          target.rgb = min (target.rgb + ((source.rgb * factor) >> 8), 255)
+        //   MULTIPLY:     target     = (target * min (scaled + 1 + extra, 256)) >> 8, donde
+        //                 scaled = premultiplied ? (source * opacity) >> 8 : source y
+        //                 extra  = premultiplied ? 256 - alpha : 0
+        // Las tres implementaciones producen exactamente el mismo resultado.
+
+        inline void blend_pixels_scalar (byte * target, const byte * source, size_t count, Canvas::Blending blending, unsigned opacity, bool premultiplied)
+        {
+            for ( ; count; --count, target += 4, source += 4)
+            {
+                unsigned alpha = (source[3] * opacity) >> 8;
+
+                alpha += alpha >> 7;
+
+                unsigned inverse = 256 - alpha;
+                unsigned factor  = premultiplied ? opacity : alpha;
+
+                switch (blending)
+                {
+                    case Canvas::MULTIPLY:
+                    {
+                        for (int component = 0; component < 4; ++component)
+                        {
+                            unsigned scaled = premultiplied ? (source[component] * opacity) >> 8 : source[component];
+
+                            target[component] = byte((target[component] * std::min (scaled + 1 + (premultiplied ? inverse : 0), 256u)) >> 8);
+                        }
+
+                        break;
+                    }
+
+                    case Canvas::ADD:
+                    {
+                        for (int component = 0; component < 3; ++component)
+                        {
+                            target[component] = byte(std::min (target[component] + ((source[component] * factor) >> 8), 255u));
+                        }
+
+                        break;
+                    }
+
+                    default:
+                    {
+                        for (int component = 0; component < 4; ++component)
+                        {
+                            target[component] = byte(std::min ((source[component] * factor + target[component] * inverse) >> 8, 255u));
+                        }
+
+                        break;
+                    }
+                }
+            }
+        }
+
+        void blend_span (Rgba8888 * target, const Rgba8888 * source, size_t count, Canvas::Blending blending, unsigned opacity, bool premultiplied)
+        {
+            #if defined(BASICS_SOFTWARE_CANVAS_SSE2)
+
+                // Se procesan 4 píxeles por iteración con los componentes expandidos a 16 bits. Con
+                // ADD la máscara conserva el alfa del destino:
+
+                const __m128i zero     = _mm_setzero_si128 ();
+                const __m128i one      = _mm_set1_epi16 (1);
+                const __m128i full     = _mm_set1_epi16 (256);
+                const __m128i op       = _mm_set1_epi16 (short(opacity));
+                const __m128i rgb_mask = _mm_setr_epi16 (-1, -1, -1, 0, -1, -1, -1, 0);
+
+                for ( ; count >= 4; count -= 4, target += 4, source += 4)
+                {
+                    __m128i s       = _mm_loadu_si128 (reinterpret_cast< const __m128i * >(source));
+                    __m128i d       = _mm_loadu_si128 (reinterpret_cast< const __m128i * >(target));
+                    __m128i halves[2];
+
+                    for (int half = 0; half < 2; ++half)
+                    {
+                        __m128i s16 = half == 0 ? _mm_unpacklo_epi8 (s, zero) : _mm_unpackhi_epi8 (s, zero);
+                        __m128i d16 = half == 0 ? _mm_unpacklo_epi8 (d, zero) : _mm_unpackhi_epi8 (d, zero);
+
+                        __m128i alpha   = _mm_shufflehi_epi16 (_mm_shufflelo_epi16 (s16, 0xFF), 0xFF);
+                                alpha   = _mm_srli_epi16 (_mm_mullo_epi16 (alpha, op), 8);
+                                alpha   = _mm_add_epi16  (alpha, _mm_srli_epi16 (alpha, 7));
+                        __m128i inverse = _mm_sub_epi16  (full, alpha);
+                        __m128i factor  = premultiplied ? op : alpha;
+
+                        switch (blending)
+                        {
+                            case Canvas::MULTIPLY:
+                            {
+                                __m128i scaled = premultiplied ? _mm_srli_epi16 (_mm_mullo_epi16 (s16, op), 8) : s16;
+                                __m128i extra  = premultiplied ? _mm_add_epi16 (one, inverse) : one;
+
+                                halves[half] = _mm_srli_epi16 (_mm_mullo_epi16 (d16, _mm_min_epi16 (_mm_add_epi16 (scaled, extra), full)), 8);
+                                break;
+                            }
+
+                            case Canvas::ADD:
+                            {
+                                __m128i added = _mm_and_si128 (_mm_srli_epi16 (_mm_mullo_epi16 (s16, factor), 8), rgb_mask);
+
+                                halves[half] = _mm_add_epi16 (d16, added);
+                                break;
+                            }
+
+                            default:
+                            {
+                                halves[half] = _mm_srli_epi16
+                                (
+                                    _mm_adds_epu16 (_mm_mullo_epi16 (s16, factor), _mm_mullo_epi16 (d16, inverse)),
+                                    8
+                                );
+                                break;
+                            }
+                        }
+                    }
+
+                    _mm_storeu_si128 (reinterpret_cast< __m128i * >(target), _mm_packus_epi16 (halves[0], halves[1]));
+                }
+
+            #elif defined(BASICS_SOFTWARE_CANVAS_NEON)
+
+                // Se procesan 8 píxeles por iteración separando los componentes en planos:
+
+                const uint16x8_t one  = vdupq_n_u16 (1);
+                const uint16x8_t full = vdupq_n_u16 (256);
+                const uint16x8_t op   = vdupq_n_u16 (uint16_t(opacity));
+
+                for ( ; count >= 8; count -= 8, target += 8, source += 8)
+                {
+                    uint8x8x4_t s = vld4_u8 (reinterpret_cast< const uint8_t * >(source));
+                    uint8x8x4_t d = vld4_u8 (reinterpret_cast< const uint8_t * >(target));
+
+                    uint16x8_t  alpha   = vshrq_n_u16 (vmulq_u16 (vmovl_u8 (s.val[3]), op), 8);
+                                alpha   = vaddq_u16   (alpha, vshrq_n_u16 (alpha, 7));
+                    uint16x8_t  inverse = vsubq_u16   (full, alpha);
+                    uint16x8_t  factor  = premultiplied ? op : alpha;
+
+                    for (int component = 0; component < 4; ++component)
+                    {
+                        uint16x8_t s16 = vmovl_u8 (s.val[component]);
+                        uint16x8_t d16 = vmovl_u8 (d.val[component]);
+
+                        switch (blending)
+                        {
+                            case Canvas::MULTIPLY:
+                            {
+                                uint16x8_t scaled = premultiplied ? vshrq_n_u16 (vmulq_u16 (s16, op), 8) : s16;
+                                uint16x8_t extra  = premultiplied ? vaddq_u16 (one, inverse) : one;
+
+                                d.val[component] = vshrn_n_u16 (vmulq_u16 (d16, vminq_u16 (vaddq_u16 (scaled, extra), full)), 8);
+                                break;
+                            }
+
+                            case Canvas::ADD:
+                            {
+                                if (component < 3)
+                                {
+                                    d.val[component] = vqmovn_u16 (vaddq_u16 (d16, vshrq_n_u16 (vmulq_u16 (s16, factor), 8)));
+                                }
+
+                                break;
+                            }
+
+                            default:
+                            {
+                                d.val[component] = vshrn_n_u16 (vqaddq_u16 (vmulq_u16 (s16, factor), vmulq_u16 (d16, inverse)), 8);
+                                break;
+                            }
+                        }
+                    }
+
+                    vst4_u8 (reinterpret_cast< uint8_t * >(target), d);
+                }
+
+            #endif
+
+            // Los píxeles restantes (o todos si no hay SIMD) se mezclan uno a uno:
+
+            blend_pixels_scalar (reinterpret_cast< byte * >(target), reinterpret_cast< const byte * >(source), count, blending, opacity, premultiplied);
+        }
+
+        // Restringe el intervalo [x0, x1) a los valores de x para los que lo <= a + b * x < hi:
+
+        inline void clip (float a, float b, float lo, float hi, float & x0, float & x1)
+        {
+            if (b == 0.f)
+            {
+                if (a < lo || a >= hi) x1 = x0;
+            }
+            else
+            {
+                float xa = (lo - a) / b;
+                float xb = (hi - a) / b;
+
+                if (b < 0.f) std::swap (xa, xb);
+
+                x0 = std::max (x0, xa);
+                x1 = std::min (x1, xb);
+            }
+        }
+
+        // Recorre por filas los píxeles cuyo centro cae dentro del paralelogramo (o del triángulo)
+        // origin + s * (s_end - origin) + t * (t_end - origin), con s y t en [0, 1) (o s + t <= 1).
+        // Para cada span llama a span_function (row, column, count, s, t, ds, dt), donde s y t son
+        // los valores en el primer píxel y ds y dt lo que varían de un píxel al siguiente:
+
+        template< typename SPAN_FUNCTION >
+        size_t rasterize
+        (
+            unsigned        width,
+            unsigned        height,
+            const Point2f & origin,
+            const Point2f & s_end,
+            const Point2f & t_end,
+            bool            triangle,
+            SPAN_FUNCTION   span_function
+        )
+        {
+            const float infinity = std::numeric_limits< float >::infinity ();
+
+            float e1x = s_end[0] - origin[0], e1y = s_end[1] - origin[1];
+            float e2x = t_end[0] - origin[0], e2y = t_end[1] - origin[1];
+            float det = e1x * e2y - e1y * e2x;
+
+            if (std::fabs (det) < 1e-6f) return 0;
+
+            float s_dx =  e2y / det, s_dy = -e2x / det;
+            float t_dx = -e1y / det, t_dy =  e1x / det;
+
+            float min_y = std::min (origin[1], std::min (s_end[1], t_end[1]));
+            float max_y = std::max (origin[1], std::max (s_end[1], t_end[1]));
+
+            if (!triangle)
+            {
+                float fourth_y = s_end[1] + t_end[1] - origin[1];
+
+                min_y = std::min (min_y, fourth_y);
+                max_y = std::max (max_y, fourth_y);
+            }
+
+            int    first_row = std::max (0,          int(std::floor (min_y)));
+            int     last_row = std::min (int(height), int(std::ceil  (max_y)));
+            size_t    pixels = 0;
+
+            for (int row = first_row; row < last_row; ++row)
+            {
+                float y  = row + 0.5f - origin[1];
+                float s0 = s_dy * y - s_dx * origin[0];             // Valores de s y t en x = 0
+                float t0 = t_dy * y - t_dx * origin[0];
+                float x0 = 0.f;
+                float x1 = float(width);
+
+                if (triangle)
+                {
+                    clip (s0,      s_dx,        0.f, infinity, x0, x1);
+                    clip (t0,      t_dx,        0.f, infinity, x0, x1);
+                    clip (s0 + t0, s_dx + t_dx, -infinity, 1.f, x0, x1);
+                }
+                else
+                {
+                    clip (s0,      s_dx,        0.f, 1.f,      x0, x1);
+                    clip (t0,      t_dx,        0.f, 1.f,      x0, x1);
+                }
+
+                if (x1 <= x0) continue;
+
+                int first_column = std::max (0,         int(std::ceil (x0 - 0.5f)));
+                int  last_column = std::min (int(width), int(std::ceil (x1 - 0.5f)));
+
+                if (last_column > first_column)
+                {
+                    float x = first_column + 0.5f;
+
+                    span_function (unsigned(row), unsigned(first_column), unsigned(last_column - first_column), s0 + s_dx * x, t0 + t_dx * x, s_dx, t_dx);
+
+                    pixels += last_column - first_column;
+                }
+            }
+
+            return pixels;
+        }
+
+        Point2f bottom_left_of (const Point2f & where, const Size2f & size, int handling)
+        {
+            Point2f bottom_left;
+
+            switch (handling & 0x03)
+            {
+                case LEFT:   bottom_left[0] = where[0];                  break;
+                case RIGHT:  bottom_left[0] = where[0] - size[0];        break;
+                default:     bottom_left[0] = where[0] - size[0] * 0.5f; break;
+            }
+
+            switch (handling & 0x0C)
+            {
+                case TOP:    bottom_left[1] = where[1] - size[1];        break;
+                case BOTTOM: bottom_left[1] = where[1];                  break;
+                default:     bottom_left[1] = where[1] - size[1] * 0.5f; break;
+            }
+
+            return bottom_left;
+        }
+
+        inline byte to_byte (float value)
+        {
+            return byte(std::min (std::max (value, 0.f), 1.f) * 255.f + 0.5f);
+        }
+
+        inline Rgba8888 pack (byte r, byte g, byte b, byte a)
+        {
+            const byte components[] = { r, g, b, a };
+            Rgba8888   pixel;
+
+            std::memcpy (&pixel, components, sizeof(pixel));
+
+            return pixel;
+        }
+
+    }
+
+    Canvas * Software_Canvas::create (Id id, Graphics_Context::Accessor & context, const Options & options)
+    {
+        std::shared_ptr< Canvas >  canvas(new Software_Canvas(options.size));
+
+        context->add (id, canvas);
+
+        return canvas.get ();
+    }
+
+    Software_Canvas::Software_Canvas(const Size2u & size)
+    {
+        frame      = {};
+        last_frame = {};
+
+        set_size    (size);
+        reset_state ();
+    }
+
+    void Software_Canvas::reset_state ()
+    {
+        transform   = Transformation2f();
+        clear_color = pack (0, 0, 0, 255);
+        color[0]    = color[1] = color[2] = 1.f;
+        opacity     = 1.f;
+        blending    = TRANSPARENCY;
+    }
+
+    void Software_Canvas::flush ()
+    {
+        frame.frames = 1;
+        last_frame   = frame;
+        frame        = {};
+    }
+
+    void Software_Canvas::set_size (const Size2u & size)
+    {
+        color_buffer.resize (size.width, size.height);
+
+        span.resize (size.width);
+    }
+
+    void Software_Canvas::set_clear_color (float r, float g, float b)
+    {
+        clear_color = pack (to_byte (r), to_byte (g), to_byte (b), 255);
+    }
+
+    void Software_Canvas::set_color (float r, float g, float b)
+    {
+        color[0] = r;
+        color[1] = g;
+        color[2] = b;
+    }
+
+    void Software_Canvas::set_opacity (float new_opacity)
+    {
+        opacity = new_opacity;
+    }
+
+    void Software_Canvas::set_blending (Blending new_blending)
+    {
+        blending = new_blending;
+    }
+
+    void Software_Canvas::set_transform (const Transformation2f & new_transform)
+    {
+        transform = new_transform;
+    }
+
+    void Software_Canvas::apply_transform (const Transformation2f & t)
+    {
+        transform = t * transform;
+    }
+
+    void Software_Canvas::clear ()
+    {
+        std::fill (color_buffer.buffer.begin (), color_buffer.buffer.end (), clear_color);
+    }
+
+    void Software_Canvas::draw_point (const Point2f & position)
+    {
+        Point2f  pixel = to_pixels (position);
+        int      x     = int(std::floor (pixel[0]));
+        int      y     = int(std::floor (pixel[1]));
+
+        if (x >= 0 && y >= 0 && unsigned(x) < color_buffer.width && unsigned(y) < color_buffer.height)
+        {
+            Rgba8888 source = get_color ();
+
+            blend_pixels (&color_buffer[y * color_buffer.width + x], &source, 1);
+
+            frame.pixels++;
+        }
+
+        frame.draws++;
+    }
+
+    void Software_Canvas::draw_segment (const Point2f & a, const Point2f & b)
+    {
+        // Los segmentos se trazan con un DDA simple sobre los píxeles del buffer:
+
+        Point2f  start  = to_pixels (a);
+        Point2f  end    = to_pixels (b);
+        float    dx     = end[0] - start[0];
+        float    dy     = end[1] - start[1];
+        int      steps  = int(std::ceil (std::max (std::fabs (dx), std::fabs (dy))));
+        Rgba8888 source = get_color ();
+
+        if (steps == 0) steps = 1;
+
+        for (int step = 0; step <= steps; ++step)
+        {
+            int x = int(std::floor (start[0] + dx * step / steps));
+            int y = int(std::floor (start[1] + dy * step / steps));
+
+            if (x >= 0 && y >= 0 && unsigned(x) < color_buffer.width && unsigned(y) < color_buffer.height)
+            {
+                blend_pixels (&color_buffer[y * color_buffer.width + x], &source, 1);
+
+                frame.pixels++;
+            }
+        }
+
+        frame.draws++;
+    }
+
+    void Software_Canvas::draw_triangle (const Point2f & a, const Point2f & b, const Point2f & c)
+    {
+        draw_segment (a, b);
+        draw_segment (b, c);
+        draw_segment (c, a);
+    }
+
+    void Software_Canvas::fill_triangle (const Point2f & a, const Point2f & b, const Point2f & c)
+    {
+        fill_polygon (to_pixels (a), to_pixels (b), to_pixels (c), true);
+    }
+
+    void Software_Canvas::draw_rectangle (const Point2f & bottom_left, const Size2f & size)
+    {
+        Point2f bottom_right{ bottom_left[0] + size.width, bottom_left[1]               };
+        Point2f    top_right{ bottom_left[0] + size.width, bottom_left[1] + size.height };
+        Point2f    top_left { bottom_left[0],              bottom_left[1] + size.height };
+
+        draw_segment (bottom_left,  bottom_right);
+        draw_segment (bottom_right, top_right   );
+        draw_segment (top_right,    top_left    );
+        draw_segment (top_left,     bottom_left );
+    }
+
+    void Software_Canvas::fill_rectangle (const Point2f & bottom_left, const Size2f & size)
+    {
+        Point2f bottom_right{ bottom_left[0] + size.width, bottom_left[1]               };
+        Point2f    top_left { bottom_left[0],              bottom_left[1] + size.height };
+
+        fill_polygon (to_pixels (bottom_left), to_pixels (bottom_right), to_pixels (top_left), false);
+    }
+
+    void Software_Canvas::fill_rectangle (const Point2f & where, const Size2f & size, const Texture_2D * texture, int handling)
+    {
+        const Memory_Texture_2D * memory_texture = dynamic_cast< const Memory_Texture_2D * >(texture);
+
+        if (memory_texture)
+        {
+            float   width  = memory_texture->get_width  ();
+            float   height = memory_texture->get_height ();
+
+            // Las coordenadas de textura se expresan en texels y la fila 0 es la superior:
+
+            Point2f texture_uvs[] =
+            {
+                { 0.f,   height },
+                { 0.f,   0.f    },
+                { width, height },
+                { width, 0.f    },
+            };
+
+            if (handling & FLIP_HORIZONTAL)
+            {
+                std::swap (texture_uvs[0][0], texture_uvs[2][0]);
+                std::swap (texture_uvs[1][0], texture_uvs[3][0]);
+            }
+
+            if (handling & FLIP_VERTICAL)
+            {
+                std::swap (texture_uvs[0][1], texture_uvs[1][1]);
+                std::swap (texture_uvs[2][1], texture_uvs[3][1]);
+            }
+
+            fill_textured_quad (memory_texture, bottom_left_of (where, size, handling), size, texture_uvs);
+        }
+    }
+
+    void Software_Canvas::fill_rectangle (const Point2f & where, const Size2f & size, const Atlas::Slice * slice, int handling)
+    {
+        if (!slice || !slice->atlas)
+        {
+            return;
+        }
+
+        const Memory_Texture_2D * memory_texture = dynamic_cast< const Memory_Texture_2D * >(slice->atlas->get_texture ().get ());
+
+        if (memory_texture)
+        {
+            Point2f texture_uvs[] =
+            {
+                { slice->left,  slice->top    },
+                { slice->left,  slice->bottom },
+                { slice->right, slice->top    },
+                { slice->right, slice->bottom },
+            };
+
+            if (handling & FLIP_HORIZONTAL)
+            {
+                std::swap (texture_uvs[0][0], texture_uvs[2][0]);
+                std::swap (texture_uvs[1][0], texture_uvs[3][0]);
+            }
+
+            if (handling & FLIP_VERTICAL)
+            {
+                std::swap (texture_uvs[0][1], texture_uvs[1][1]);
+                std::swap (texture_uvs[2][1], texture_uvs[3][1]);
+            }
+
+            fill_textured_quad (memory_texture, bottom_left_of (where, size, handling), size, texture_uvs);
+        }
+    }
+
+    Point2f Software_Canvas::to_pixels (const Point2f & point) const
+    {
+        // Se aplica la transformación y se invierte el eje Y porque la fila 0 es la superior:
+
+        const auto & m = transform.matrix;
+
+        float x = m[0][0] * point[0] + m[0][1] * point[1] + m[0][2];
+        float y = m[1][0] * point[0] + m[1][1] * point[1] + m[1][2];
+
+        return { x, float(color_buffer.height) - y };
+    }
+
+    Rgba8888 Software_Canvas::get_color () const
+    {
+        return pack (to_byte (color[0]), to_byte (color[1]), to_byte (color[2]), 255);
+    }
+
+    void Software_Canvas::fill_polygon (const Point2f & origin, const Point2f & s_end, const Point2f & t_end, bool triangle)
+    {
+        Rgba8888 source = get_color ();
+
+        frame.pixels += rasterize
+        (
+            color_buffer.width, color_buffer.height, origin, s_end, t_end, triangle,
+            [this, source] (unsigned row, unsigned column, unsigned count, float, float, float, float)
+            {
+                std::fill_n (span.begin (), count, source);
+
+                blend_pixels (&color_buffer[row * color_buffer.width + column], span.data (), count);
+            }
+        );
+
+        frame.draws++;
+    }
+
+    void Software_Canvas::fill_textured_quad
+    (
+        const Memory_Texture_2D * texture,
+        const Point2f           & bottom_left,
+        const Size2f            & size,
+        const Point2f           * texture_uvs
+    )
+    {
+        const Buffer & texels         = texture->get_color_buffer ();
+        const int      texture_width  = int(texels.width );
+        const int      texture_height = int(texels.height);
+
+        if (texture_width == 0 || texture_height == 0) return;
+
+        // Las coordenadas de textura varían linealmente con s (de izquierda a derecha) y con t
+        // (de abajo arriba):
+
+        const Point2f & uv = texture_uvs[0];
+        const float     du_ds = texture_uvs[2][0] - uv[0], dv_ds = texture_uvs[2][1] - uv[1];
+        const float     du_dt = texture_uvs[1][0] - uv[0], dv_dt = texture_uvs[1][1] - uv[1];
+
+        Point2f bottom_right{ bottom_left[0] + size.width, bottom_left[1]               };
+        Point2f    top_left { bottom_left[0],              bottom_left[1] + size.height };
+
+        frame.pixels += rasterize
+        (
+            color_buffer.width, color_buffer.height, to_pixels (bottom_left), to_pixels (bottom_right), to_pixels (top_left), false,
+            [&] (unsigned row, unsigned column, unsigned count, float s, float t, float ds, float dt)
+            {
+                float u  = uv[0] + s  * du_ds + t  * du_dt;
+                float v  = uv[1] + s  * dv_ds + t  * dv_dt;
+                float du =         ds * du_ds + dt * du_dt;
+                float dv =         ds * dv_ds + dt * dv_dt;
+
+                for (unsigned index = 0; index < count; ++index, u += du, v += dv)
+                {
+                    int x = std::min (std::max (int(u), 0), texture_width  - 1);
+                    int y = std::min (std::max (int(v), 0), texture_height - 1);
+
+                    span[index] = texels[y * texture_width + x];
+                }
+
+                blend_pixels (&color_buffer[row * color_buffer.width + column], span.data (), count, texture->is_premultiplied ());
+            }
+        );
+
+        frame.draws++;
+    }
+
+    void Software_Canvas::blend_pixels (Rgba8888 * target, const Rgba8888 * source, size_t count, bool premultiplied)
+    {
+        if (blending == NONE)
+        {
+            std::memcpy (target, source, count * sizeof(Rgba8888));
+        }
+        else
+        {
+            unsigned opacity_256 = unsigned(std::min (std::max (opacity, 0.f), 1.f) * 256.f + 0.5f);
+
+            blend_span (target, source, count, blending, opacity_256, premultiplied);
+        }
+    }
+
+}
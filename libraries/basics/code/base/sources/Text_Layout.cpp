@@ -15,18 +15,79 @@
 namespace basics
 {
 
+    Text_Layout::Text_Layout()
+    :
+        width      (0.f),
+        height     (0.f),
+        font_serial(0  )
+    {
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
     Text_Layout::Text_Layout(const Raster_Font & font, const std::wstring & text)
     :
-        width (0.f),
-        height(0.f)
+        Text_Layout()
+    {
+        assign (font, text);
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Text_Layout::assign (const Raster_Font & font, const std::wstring & text)
+    {
+        assign (font, text.data (), text.data () + text.length ());
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Text_Layout::assign_number (const Raster_Font & font, int number)
+    {
+        // Los dígitos se escriben de derecha a izquierda en un búfer en la pila. El valor absoluto se
+        // calcula sin signo para que INT_MIN no se desborde:
+
+        wchar_t   digits[12];
+        wchar_t * end   = digits + 12;
+        wchar_t * begin = end;
+        unsigned  value = number < 0 ? 0u - unsigned(number) : unsigned(number);
+
+        do
+        {
+            *--begin = wchar_t(L'0' + value % 10);
+            value   /= 10;
+        }
+        while (value > 0);
+
+        if (number < 0) *--begin = L'-';
+
+        assign (font, begin, end);
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Text_Layout::assign (const Raster_Font & font, const wchar_t * begin, const wchar_t * end)
     {
+        // Si no ha cambiado nada los glifos calculados siguen siendo válidos:
+
+        if (font_serial == font.get_serial () && text.compare (0, std::wstring::npos, begin, size_t(end - begin)) == 0) return;
+
+        font_serial = font.get_serial ();
+
+        text.assign (begin, end);
+
+        // Se vacía la lista de glifos conservando su capacidad:
+
+        glyphs.clear ();
+
+        width  = 0.f;
+        height = 0.f;
+
         Raster_Font::Metrics metrics = font.get_metrics ();
 
         glyphs.reserve (text.length ());
 
         float current_x  = 0;
         float current_y  = -metrics.line_height;
-        float line_width = 0;
 
         for (auto & c : text)
         {
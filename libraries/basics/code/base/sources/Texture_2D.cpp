@@ -10,15 +10,40 @@
  * C1801161300
  */
 
+#include <basics/Asset_Loader>
+#include <basics/etc1>
+#include <basics/pixel_conversion>
 #include <basics/png_decode>
+#include <basics/raw_texture>
 #include <basics/Texture_2D>
 
 namespace basics
 {
 
-    Id                  Texture_2D::texture_2d_specialization_ids      [10];
-    Texture_2D::Factory Texture_2D::texture_2d_specialization_factories[10];
-    size_t              Texture_2D::texture_2d_specialization_count;
+    namespace
+    {
+
+        // Las dimensiones, la opacidad y el alfa premultiplicado se toman de la imagen y el resto de
+        // opciones, de las recibidas al crear la textura:
+
+        Texture_2D::Options merge_options (const Texture_2D::Options & options, const Texture_2D::Options & image)
+        {
+            Texture_2D::Options merged = options;
+
+            merged.width         = image.width;
+            merged.height        = image.height;
+            merged.opaque        = image.opaque;
+            merged.premultiplied = image.premultiplied;
+
+            return merged;
+        }
+
+    }
+
+    Id                             Texture_2D::texture_2d_specialization_ids                 [10];
+    Texture_2D::Factory            Texture_2D::texture_2d_specialization_factories           [10];
+    Texture_2D::Compressed_Factory Texture_2D::texture_2d_specialization_compressed_factories[10];
+    size_t                         Texture_2D::texture_2d_specialization_count;
 
     std::shared_ptr< Texture_2D > Texture_2D::create (Id id, Graphics_Context::Accessor & context, Color_Buffer< Rgba8888 > & color_buffer, const Options & options)
     {
@@ -35,27 +60,168 @@ namespace basics
         return std::shared_ptr< Texture_2D >();
     }
 
+    std::shared_ptr< Texture_2D > Texture_2D::create (Id id, Graphics_Context::Accessor & context, Compressed_Image & compressed_image, const Options & options)
+    {
+        Id context_id = context->get_id ();
+
+        for (unsigned index = 0; index < texture_2d_specialization_count; ++index)
+        {
+            if (texture_2d_specialization_ids[index] == context_id && texture_2d_specialization_compressed_factories[index])
+            {
+                return texture_2d_specialization_compressed_factories[index] (id, compressed_image, options);
+            }
+        }
+
+        // Si el contexto no admite texturas comprimidas, se descomprime la imagen:
+
+        Color_Buffer< Rgba8888 > color_buffer;
+
+        if (decompress (compressed_image, color_buffer))
+        {
+            return create (id, context, color_buffer, options);
+        }
+
+        return std::shared_ptr< Texture_2D >();
+    }
+
     std::shared_ptr< Texture_2D > Texture_2D::create (Id id, Graphics_Context::Accessor & context, const std::string & asset_path, const Options & options)
     {
-        std::shared_ptr< Asset > asset = Asset::open (asset_path);
+        // Si la imagen se ha decodificado previamente en segundo plano, solo queda crear la textura.
+        // Se saca del cargador para que la textura se quede con sus píxeles sin copiarlos:
+
+        auto image = Asset_Loader::get_instance ().take_image (asset_path);
 
-        if (asset)
+        if (image)
         {
-            std::vector< byte >  data;
+            Texture_2D::Options image_options = merge_options (options, image->options);
 
-            if (asset->read_all (data))
+            if (!image->compressed_image.data.empty ())
             {
-                Color_Buffer< Rgba8888 > color_buffer;
-                Texture_2D::Options      options;
+                return Texture_2D::create (id, context, image->compressed_image, image_options);
+            }
+
+            // La imagen se decodificó sin saber si se iba a pedir con el alfa premultiplicado, por lo
+            // que si hace falta se premultiplica ahora:
+
+            if (options.premultiplied && !image_options.premultiplied)
+            {
+                if (!image_options.opaque) premultiply_alpha (image->color_buffer);
+
+                image_options.premultiplied = true;
+            }
+
+            return Texture_2D::create (id, context, image->color_buffer, image_options);
+        }
+
+        Color_Buffer< Rgba8888 > color_buffer;
+        Compressed_Image         compressed_image;
+        Texture_2D::Options      image_info;
+
+        if (load (asset_path, color_buffer, compressed_image, image_info, options.premultiplied))
+        {
+            Texture_2D::Options image_options = merge_options (options, image_info);
+
+            return compressed_image.data.empty ()
+                 ? Texture_2D::create (id, context, color_buffer,     image_options)
+                 : Texture_2D::create (id, context, compressed_image, image_options);
+        }
 
-                if (png_decode (data, color_buffer, options.width, options.height))
+        return std::shared_ptr< Texture_2D >();
+    }
+
+    bool Texture_2D::load
+    (
+        const std::string        & asset_path,
+        Color_Buffer< Rgba8888 > & color_buffer,
+        Compressed_Image         & compressed_image,
+        Options                  & options,
+        bool                       premultiply
+    )
+    {
+        std::vector< byte > data;
+
+        options = Options();
+
+        compressed_image.data.clear ();
+
+        // Se prefiere la versión en bruto de la imagen si se ha generado:
+
+        static const std::string png_extension(".png");
+
+        if (asset_path.size () > png_extension.size () && asset_path.compare (asset_path.size () - png_extension.size (), png_extension.size (), png_extension) == 0)
+        {
+            std::shared_ptr< Asset > raw_asset = Asset::open (asset_path.substr (0, asset_path.size () - png_extension.size ()) + raw_texture_extension);
+
+            if (raw_asset && raw_asset->read_all (data))
+            {
+                const Raw_Texture_Header * header = raw_texture_header (data);
+
+                // Los bloques comprimidos se conservan tal cual para subirlos sin descomprimir:
+
+                if (header && header->format == Raw_Texture_Header::ETC1_RGB8)
                 {
-                    return Texture_2D::create (id, context, color_buffer, options);
+                    const byte * pixels = data.data () + sizeof(Raw_Texture_Header);
+
+                    compressed_image.format = Compressed_Image::ETC1_RGB8;
+                    compressed_image.width  = options.width  = header->width;
+                    compressed_image.height = options.height = header->height;
+                    compressed_image.data.assign (pixels, pixels + header->data_size);
+
+                    options.opaque        = true;
+                    options.premultiplied = premultiply;
+
+                    color_buffer.resize (0, 0);
+
+                    return true;
+                }
+
+                bool premultiplied;
+
+                if (raw_texture_decode (data, color_buffer, options.width, options.height, options.opaque, premultiplied))
+                {
+                    if (premultiply && !premultiplied && !options.opaque) premultiply_alpha (color_buffer);
+
+                    options.premultiplied = premultiply || premultiplied;
+
+                    return true;
                 }
             }
         }
 
-        return std::shared_ptr< Texture_2D >();
+        std::shared_ptr< Asset > asset = Asset::open (asset_path);
+
+        if (asset && asset->read_all (data) && png_decode (data, color_buffer, options.width, options.height, options.opaque))
+        {
+            // Las imágenes opacas no cambian al premultiplicarlas:
+
+            if (premultiply && !options.opaque) premultiply_alpha (color_buffer);
+
+            options.premultiplied = premultiply;
+
+            return true;
+        }
+
+        return false;
+    }
+
+    bool Texture_2D::decompress (const Compressed_Image & compressed_image, Color_Buffer< Rgba8888 > & color_buffer)
+    {
+        switch (compressed_image.format)
+        {
+            case Compressed_Image::ETC1_RGB8:
+            {
+                return etc1_decode
+                (
+                    compressed_image.data.data (),
+                    compressed_image.data.size (),
+                    compressed_image.width,
+                    compressed_image.height,
+                    color_buffer
+                );
+            }
+        }
+
+        return false;
     }
 
 }
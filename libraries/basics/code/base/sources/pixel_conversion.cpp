@@ -0,0 +1,286 @@
+/*
+ * PIXEL CONVERSION
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610172240
+ */
+
+#include <algorithm>
+#include <basics/pixel_conversion>
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+    #include <arm_neon.h>
+    #define BASICS_PIXEL_CONVERSION_NEON
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define BASICS_PIXEL_CONVERSION_SSE2
+#endif
+
+namespace basics
+{
+
+    namespace
+    {
+
+        // Umbrales de la matriz de Bayer de 4x4 escalados al rango [8, 248]. Sin tramado se usa
+        // siempre el umbral central, lo que equivale a redondear:
+
+        const unsigned bayer_thresholds[4][4] =
+        {
+            {   8, 136,  40, 168 },
+            { 200,  72, 232, 104 },
+            {  56, 184,  24, 152 },
+            { 248, 120, 216,  88 },
+        };
+
+        const unsigned rounding_threshold = 127;
+
+        // Cuantiza un canal de 8 bits a un valor entre 0 y maximum:
+
+        inline unsigned quantize (unsigned value, unsigned maximum, unsigned threshold)
+        {
+            return (value * maximum + threshold) / 255;
+        }
+
+        template< typename PACK >
+        void convert_16 (const Rgba8888 * source, unsigned width, unsigned height, std::vector< uint16_t > & target, bool dither, PACK pack)
+        {
+            const byte * pixel = reinterpret_cast< const byte * >(source);
+
+            target.resize (size_t(width) * height);
+
+            uint16_t * output = target.data ();
+
+            for (unsigned y = 0; y < height; ++y)
+            {
+                for (unsigned x = 0; x < width; ++x, pixel += 4)
+                {
+                    *output++ = pack (pixel, dither ? bayer_thresholds[y & 3][x & 3] : rounding_threshold);
+                }
+            }
+        }
+
+    }
+
+    void convert_to_rgb565 (const Color_Buffer< Rgba8888 > & source, std::vector< uint16_t > & target, bool dither)
+    {
+        convert_to_rgb565 (source.buffer.data (), source.get_width (), source.get_height (), target, dither);
+    }
+
+    void convert_to_rgba4444 (const Color_Buffer< Rgba8888 > & source, std::vector< uint16_t > & target, bool dither)
+    {
+        convert_to_rgba4444 (source.buffer.data (), source.get_width (), source.get_height (), target, dither);
+    }
+
+    void convert_to_a8 (const Color_Buffer< Rgba8888 > & source, std::vector< uint8_t > & target)
+    {
+        convert_to_a8 (source.buffer.data (), source.get_width (), source.get_height (), target);
+    }
+
+    void convert_to_rgb565 (const Rgba8888 * source, unsigned width, unsigned height, std::vector< uint16_t > & target, bool dither)
+    {
+        convert_16
+        (
+            source, width, height, target, dither,
+            [] (const byte * pixel, unsigned threshold)
+            {
+                return uint16_t
+                (
+                    quantize (pixel[0], 31, threshold) << 11 |
+                    quantize (pixel[1], 63, threshold) <<  5 |
+                    quantize (pixel[2], 31, threshold)
+                );
+            }
+        );
+    }
+
+    void convert_to_rgba4444 (const Rgba8888 * source, unsigned width, unsigned height, std::vector< uint16_t > & target, bool dither)
+    {
+        convert_16
+        (
+            source, width, height, target, dither,
+            [] (const byte * pixel, unsigned threshold)
+            {
+                return uint16_t
+                (
+                    quantize (pixel[0], 15, threshold) << 12 |
+                    quantize (pixel[1], 15, threshold) <<  8 |
+                    quantize (pixel[2], 15, threshold) <<  4 |
+                    quantize (pixel[3], 15, threshold)
+                );
+            }
+        );
+    }
+
+    void convert_to_a8 (const Rgba8888 * source, unsigned width, unsigned height, std::vector< uint8_t > & target)
+    {
+        size_t       count = size_t(width) * height;
+        const byte * pixel = reinterpret_cast< const byte * >(source);
+
+        target.resize (count);
+
+        for (size_t index = 0; index < count; ++index, pixel += 4)
+        {
+            target[index] = pixel[3];
+        }
+    }
+
+    void downsample_2x2 (const Color_Buffer< Rgba8888 > & source, Color_Buffer< Rgba8888 > & target)
+    {
+        unsigned source_width  = source.get_width  ();
+        unsigned source_height = source.get_height ();
+        unsigned target_width  = std::max (source_width  / 2, 1u);
+        unsigned target_height = std::max (source_height / 2, 1u);
+
+        target.resize (target_width, target_height);
+
+        const byte * pixels = reinterpret_cast< const byte * >(source.buffer.data ());
+        byte       * output = target;
+
+        for (unsigned y = 0; y < target_height; ++y)
+        {
+            const byte * row_0 = pixels + size_t(std::min (y * 2,     source_height - 1)) * source_width * 4;
+            const byte * row_1 = pixels + size_t(std::min (y * 2 + 1, source_height - 1)) * source_width * 4;
+
+            unsigned x = 0;
+
+            // Cada iteración lee 4 píxeles de cada fila y produce 2. Los canales se suman con 16 bits
+            // para que el redondeo coincida con el del bucle escalar:
+
+            if (source_width >= 2)
+            {
+                #if defined(BASICS_PIXEL_CONVERSION_SSE2)
+
+                    const __m128i zero = _mm_setzero_si128 ();
+                    const __m128i two  = _mm_set1_epi16   (2);
+
+                    for ( ; x + 2 <= source_width / 2; x += 2, output += 8)
+                    {
+                        __m128i a = _mm_loadu_si128 (reinterpret_cast< const __m128i * >(row_0 + x * 8));
+                        __m128i b = _mm_loadu_si128 (reinterpret_cast< const __m128i * >(row_1 + x * 8));
+
+                        __m128i low  = _mm_add_epi16 (_mm_unpacklo_epi8 (a, zero), _mm_unpacklo_epi8 (b, zero));
+                        __m128i high = _mm_add_epi16 (_mm_unpackhi_epi8 (a, zero), _mm_unpackhi_epi8 (b, zero));
+
+                        low  = _mm_add_epi16 (low,  _mm_srli_si128 (low,  8));
+                        high = _mm_add_epi16 (high, _mm_srli_si128 (high, 8));
+
+                        __m128i sum = _mm_srli_epi16 (_mm_add_epi16 (_mm_unpacklo_epi64 (low, high), two), 2);
+
+                        _mm_storel_epi64 (reinterpret_cast< __m128i * >(output), _mm_packus_epi16 (sum, sum));
+                    }
+
+                #elif defined(BASICS_PIXEL_CONVERSION_NEON)
+
+                    for ( ; x + 2 <= source_width / 2; x += 2, output += 8)
+                    {
+                        uint8x16_t a = vld1q_u8 (row_0 + x * 8);
+                        uint8x16_t b = vld1q_u8 (row_1 + x * 8);
+
+                        uint16x8_t low  = vaddl_u8 (vget_low_u8  (a), vget_low_u8  (b));
+                        uint16x8_t high = vaddl_u8 (vget_high_u8 (a), vget_high_u8 (b));
+
+                        uint16x8_t sum  = vcombine_u16
+                        (
+                            vadd_u16 (vget_low_u16 (low ), vget_high_u16 (low )),
+                            vadd_u16 (vget_low_u16 (high), vget_high_u16 (high))
+                        );
+
+                        vst1_u8 (output, vrshrn_n_u16 (sum, 2));
+                    }
+
+                #endif
+            }
+
+            for ( ; x < target_width; ++x, output += 4)
+            {
+                unsigned left  = std::min (x * 2,     source_width - 1) * 4;
+                unsigned right = std::min (x * 2 + 1, source_width - 1) * 4;
+
+                for (unsigned channel = 0; channel < 4; ++channel)
+                {
+                    output[channel] = byte
+                    (
+                        (row_0[left + channel] + row_0[right + channel] + row_1[left + channel] + row_1[right + channel] + 2) >> 2
+                    );
+                }
+            }
+        }
+    }
+
+    void premultiply_alpha (Color_Buffer< Rgba8888 > & color_buffer)
+    {
+        byte   * pixel = color_buffer;
+        size_t   count = color_buffer.size ();
+
+        // (c * a + 127) / 255 se calcula sin dividir como (t + (t >> 8)) >> 8 con t = c * a + 128,
+        // que da el mismo resultado para todos los valores de c y de a:
+
+        #if defined(BASICS_PIXEL_CONVERSION_SSE2)
+
+            // Cada iteración procesa 4 píxeles. El alfa de cada píxel se repite en sus cuatro canales
+            // y en el canal alfa se sustituye por 255 para que no cambie:
+
+            const __m128i zero        = _mm_setzero_si128 ();
+            const __m128i alpha_lanes = _mm_setr_epi16    (0, 0, 0, -1, 0, 0, 0, -1);
+            const __m128i alpha_keep  = _mm_setr_epi16    (0, 0, 0, 255, 0, 0, 0, 255);
+            const __m128i half        = _mm_set1_epi16    (128);
+
+            auto multiply = [&] (__m128i channels)
+            {
+                __m128i alphas = _mm_shufflehi_epi16 (_mm_shufflelo_epi16 (channels, _MM_SHUFFLE (3, 3, 3, 3)), _MM_SHUFFLE (3, 3, 3, 3));
+
+                alphas = _mm_or_si128 (_mm_andnot_si128 (alpha_lanes, alphas), alpha_keep);
+
+                __m128i t = _mm_add_epi16 (_mm_mullo_epi16 (channels, alphas), half);
+
+                return _mm_srli_epi16 (_mm_add_epi16 (t, _mm_srli_epi16 (t, 8)), 8);
+            };
+
+            for ( ; count >= 4; count -= 4, pixel += 16)
+            {
+                __m128i pixels = _mm_loadu_si128 (reinterpret_cast< const __m128i * >(pixel));
+                __m128i low    = multiply (_mm_unpacklo_epi8 (pixels, zero));
+                __m128i high   = multiply (_mm_unpackhi_epi8 (pixels, zero));
+
+                _mm_storeu_si128 (reinterpret_cast< __m128i * >(pixel), _mm_packus_epi16 (low, high));
+            }
+
+        #elif defined(BASICS_PIXEL_CONVERSION_NEON)
+
+            // Cada iteración procesa 8 píxeles separados por canales:
+
+            for ( ; count >= 8; count -= 8, pixel += 32)
+            {
+                uint8x8x4_t pixels = vld4_u8 (pixel);
+
+                for (int channel = 0; channel < 3; ++channel)
+                {
+                    uint16x8_t product = vmull_u8 (pixels.val[channel], pixels.val[3]);
+
+                    pixels.val[channel] = vrshrn_n_u16 (vrsraq_n_u16 (product, product, 8), 8);
+                }
+
+                vst4_u8 (pixel, pixels);
+            }
+
+        #endif
+
+        // Píxeles restantes (o todos si no hay instrucciones SIMD):
+
+        for ( ; count > 0; --count, pixel += 4)
+        {
+            unsigned alpha = pixel[3];
+
+            pixel[0] = byte((pixel[0] * alpha + 127) / 255);
+            pixel[1] = byte((pixel[1] * alpha + 127) / 255);
+            pixel[2] = byte((pixel[2] * alpha + 127) / 255);
+        }
+    }
+
+}
@@ -0,0 +1,90 @@
+/*
+ * RAW ATLAS
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610181010
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <basics/raw_atlas>
+
+namespace basics
+{
+
+    namespace
+    {
+
+        const char     magic[4] = { 'B', 'A', 'T', 'L' };
+        const uint16_t version  = 2;
+
+    }
+
+    const char raw_atlas_extension[] = ".batl";
+
+    const Raw_Atlas_Header * raw_atlas_header (const std::vector< byte > & encoded_data)
+    {
+        if (encoded_data.size () < sizeof(Raw_Atlas_Header)) return nullptr;
+
+        auto header = reinterpret_cast< const Raw_Atlas_Header * >(encoded_data.data ());
+
+        if (std::memcmp (header->magic, magic, sizeof(magic)) != 0 || header->version != version)
+        {
+            return nullptr;
+        }
+
+        uint64_t size = sizeof(Raw_Atlas_Header) + uint64_t(header->slice_count) * sizeof(Raw_Atlas_Slice) + header->name_size;
+
+        if (encoded_data.size () < size)
+        {
+            return nullptr;
+        }
+
+        return header;
+    }
+
+    bool raw_atlas_encode
+    (
+        const std::string              & texture_name,
+        uint32_t                         source_hash,
+        std::vector< Raw_Atlas_Slice >   slices,
+        std::vector< byte >            & encoded_data
+    )
+    {
+        std::sort
+        (
+            slices.begin (), slices.end (),
+            [] (const Raw_Atlas_Slice & a, const Raw_Atlas_Slice & b) { return a.id < b.id; }
+        );
+
+        for (size_t index = 1; index < slices.size (); ++index)
+        {
+            if (slices[index].id == slices[index - 1].id) return false;
+        }
+
+        Raw_Atlas_Header header{};
+
+        std::memcpy (header.magic, magic, sizeof(magic));
+
+        header.version     = version;
+        header.name_size   = uint16_t(texture_name.size ());
+        header.slice_count = uint32_t(slices.size ());
+        header.source_hash = source_hash;
+
+        size_t slices_size = slices.size () * sizeof(Raw_Atlas_Slice);
+
+        encoded_data.resize (sizeof(header) + slices_size + header.name_size);
+
+        std::memcpy (encoded_data.data (), &header, sizeof(header));
+        std::memcpy (encoded_data.data () + sizeof(header), slices.data (), slices_size);
+        std::memcpy (encoded_data.data () + sizeof(header) + slices_size, texture_name.data (), header.name_size);
+
+        return true;
+    }
+
+}
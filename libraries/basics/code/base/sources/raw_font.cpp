@@ -0,0 +1,99 @@
+/*
+ * RAW FONT
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610181020
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <basics/raw_font>
+
+namespace basics
+{
+
+    namespace
+    {
+
+        const char     magic[4] = { 'B', 'F', 'N', 'T' };
+        const uint16_t version  = 2;
+
+    }
+
+    const char raw_font_extension[] = ".bfnt";
+
+    const Raw_Font_Header * raw_font_header (const std::vector< byte > & encoded_data)
+    {
+        if (encoded_data.size () < sizeof(Raw_Font_Header)) return nullptr;
+
+        auto header = reinterpret_cast< const Raw_Font_Header * >(encoded_data.data ());
+
+        if (std::memcmp (header->magic, magic, sizeof(magic)) != 0 || header->version != version)
+        {
+            return nullptr;
+        }
+
+        uint64_t size = sizeof(Raw_Font_Header) + uint64_t(header->glyph_count) * sizeof(Raw_Font_Glyph) + header->face_size + header->name_size;
+
+        if (encoded_data.size () < size)
+        {
+            return nullptr;
+        }
+
+        return header;
+    }
+
+    bool raw_font_encode
+    (
+        const std::string             & face,
+        const std::string             & texture_name,
+        unsigned                        line_height,
+        unsigned                        base,
+        uint32_t                        source_hash,
+        std::vector< Raw_Font_Glyph >   glyphs,
+        std::vector< byte >           & encoded_data
+    )
+    {
+        std::sort
+        (
+            glyphs.begin (), glyphs.end (),
+            [] (const Raw_Font_Glyph & a, const Raw_Font_Glyph & b) { return a.code < b.code; }
+        );
+
+        for (size_t index = 1; index < glyphs.size (); ++index)
+        {
+            if (glyphs[index].code == glyphs[index - 1].code) return false;
+        }
+
+        Raw_Font_Header header{};
+
+        std::memcpy (header.magic, magic, sizeof(magic));
+
+        header.version     = version;
+        header.line_height = uint16_t(line_height);
+        header.base        = uint16_t(base);
+        header.face_size   = uint16_t(face.size ());
+        header.name_size   = uint16_t(texture_name.size ());
+        header.glyph_count = uint32_t(glyphs.size ());
+        header.source_hash = source_hash;
+
+        size_t glyphs_size = glyphs.size () * sizeof(Raw_Font_Glyph);
+
+        encoded_data.resize (sizeof(header) + glyphs_size + header.face_size + header.name_size);
+
+        byte * target = encoded_data.data ();
+
+        std::memcpy (target, &header,             sizeof(header));      target += sizeof(header);
+        std::memcpy (target, glyphs.data (),      glyphs_size);         target += glyphs_size;
+        std::memcpy (target, face.data (),        header.face_size);    target += header.face_size;
+        std::memcpy (target, texture_name.data (), header.name_size);
+
+        return true;
+    }
+
+}
@@ -16,6 +16,7 @@
     #include <memory>
     #include <basics/declarations>
     #include <basics/Event_Queue>
+    #include <basics/Frame_Profiler>
     #include <basics/Graphics_Context>
     #include <basics/Graphics_Resource_Cache>
     #include <basics/Window>
@@ -70,6 +71,10 @@
             Graphics_Context_Factory graphics_context_factory;
             Graphics_Resource_Cache  graphics_resource_cache;
 
+            Frame_Profiler           profiler;
+
+            float                    upload_budget;
+
         private:
 
             Director();
@@ -83,6 +88,24 @@
 
             Graphics_Context::Accessor lock_graphics_context ();
 
+            /**
+             * Establece el tiempo máximo (en segundos) que cada fotograma dedica a subir a la GPU las
+             * franjas de las texturas creadas con la opción staged.
+             */
+            void set_upload_budget (float seconds)
+            {
+                upload_budget = seconds;
+            }
+
+            /**
+             * Tiempos de las fases de los últimos fotogramas del bucle principal. El profiler está
+             * desactivado hasta que se activa con set_enabled(true).
+             */
+            Frame_Profiler & get_profiler ()
+            {
+                return profiler;
+            }
+
         public:
 
             void run_scene (const std::shared_ptr< Scene > & new_scene);
@@ -0,0 +1,151 @@
+/*
+ *  FRAME PROFILER
+ *  Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ *  Distributed under the Boost Software License, version  1.0
+ *  See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ *  angel.rodriguez@esne.edu
+ *
+ *  C2610171900
+ */
+
+#ifndef BASICS_FRAME_PROFILER_HEADER
+#define BASICS_FRAME_PROFILER_HEADER
+
+    #include <array>
+    #include <atomic>
+    #include <cstdint>
+    #include <memory>
+    #include <vector>
+    #include <basics/Graphics_Context>
+    #include <basics/Raster_Font>
+    #include <basics/Size>
+    #include <basics/Timer>
+
+    namespace basics
+    {
+
+        /**
+         * Mide por separado el tiempo que ocupa cada fase de los fotogramas del bucle principal del
+         * Director y guarda las muestras de los últimos fotogramas en un buffer circular.
+         * Solo el hilo del Director escribe muestras. Se pueden leer las estadísticas desde cualquier
+         * hilo sin bloqueos: las muestras que se sobrescriben mientras se copian se descartan.
+         * Opcionalmente puede dibujar sobre el canvas de la escena un resumen con un Raster_Font.
+         * Está desactivado por defecto, por lo que las marcas no cuestan nada hasta que se llama a
+         * set_enabled(true).
+         */
+        class Frame_Profiler
+        {
+        public:
+
+            enum Phase
+            {
+                EVENTS,                         ///< Cambio de escena y lectura de eventos de la aplicación y de la ventana.
+                HANDLE,                         ///< Scene::handle() con los eventos de la cola.
+                UPDATE,                         ///< Scene::update().
+                RENDER,                         ///< Scene::render() (y el resumen en pantalla si está activo).
+                DISPLAY,                        ///< Graphics_Context::flush_and_display().
+                FRAME,                          ///< Fotograma completo.
+                NUMBER_OF_PHASES
+            };
+
+            /** Duraciones en segundos de una fase en los fotogramas medidos. */
+            struct Statistics
+            {
+                size_t frames;
+                float  min;
+                float  average;
+                float  p95;
+                float  p99;
+                float  max;
+            };
+
+            static constexpr size_t capacity = 256;         ///< Número de fotogramas que se conservan.
+
+        private:
+
+            struct Sample
+            {
+                float seconds[NUMBER_OF_PHASES];
+            };
+
+            std::array< Sample, capacity > samples;
+            std::atomic< uint32_t >        written;         ///< Número total de fotogramas escritos.
+
+            bool   enabled;
+            Sample current;
+            Timer  frame_timer;
+            Timer  phase_timer;
+
+            std::shared_ptr< Raster_Font > overlay_font;
+
+        public:
+
+            Frame_Profiler();
+
+        public:
+
+            void set_enabled (bool new_enabled)
+            {
+                enabled = new_enabled;
+            }
+
+            bool is_enabled () const
+            {
+                return enabled;
+            }
+
+            /**
+             * Activa el resumen en pantalla usando el font indicado o lo desactiva si es nulo. El
+             * resumen se dibuja con la transformación identidad y opacidad 1, por lo que las escenas
+             * no deben esperar conservar ese estado del canvas de un fotograma al siguiente.
+             */
+            void set_overlay_font (const std::shared_ptr< Raster_Font > & font)
+            {
+                overlay_font = font;
+            }
+
+        public:
+
+            void begin_frame ()
+            {
+                if (enabled)
+                {
+                    current = Sample{};
+
+                    frame_timer.reset ();
+                    phase_timer.reset ();
+                }
+            }
+
+            /** Suma a la fase indicada el tiempo transcurrido desde la marca anterior. */
+            void mark (Phase phase)
+            {
+                if (enabled)
+                {
+                    current.seconds[phase] += phase_timer.get_elapsed_seconds ();
+
+                    phase_timer.reset ();
+                }
+            }
+
+            void end_frame ();
+
+        public:
+
+            /** Estadísticas de una fase en los últimos fotogramas (como mucho, capacity). */
+            Statistics get_statistics (Phase phase) const;
+
+            /** Dibuja el resumen (si está activo y hay un font) en la esquina superior izquierda del canvas. */
+            void draw_overlay (Graphics_Context::Accessor & context, const Size2u & view_size) const;
+
+        private:
+
+            void copy_samples (std::vector< Sample > & copy) const;
+
+        };
+
+    }
+
+#endif
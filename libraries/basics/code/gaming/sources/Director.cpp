@@ -11,13 +11,20 @@
  */
 
 #include <basics/Application>
+#include <basics/Asset_Cache>
+#include <basics/Canvas>
 #include <basics/Director>
 #include <basics/Log>
+#include <basics/macros>
 #include <basics/Scene>
 #include <basics/Timer>
 #include <basics/Window>
-#include <basics/opengles/Canvas_ES2>
-#include <basics/opengles/Context>
+
+#if defined(BASICS_ANDROID_OS)
+
+    #include <basics/opengles/Context>
+
+#endif
 
 namespace basics
 {
@@ -29,7 +36,16 @@ namespace basics
     Director::Director()
     {
         kernel.running           = false;
-        graphics_context_factory = opengles::Context::create;
+        upload_budget            = 0.004f;
+
+        // OpenGL ES is used by default on Android. Other platforms must set a context factory with
+        // set_graphics_context_factory() (Headless_Context::create, for example):
+
+        #if defined(BASICS_ANDROID_OS)
+            graphics_context_factory = opengles::Context::create;
+        #else
+            graphics_context_factory = nullptr;
+        #endif
     }
 
     // ---------------------------------------------------------------------------------------------
@@ -87,6 +103,8 @@ namespace basics
             Timer timer;
             bool  reset_canvas = false;
 
+            profiler.begin_frame ();
+
             // Check if the current scene must be replaced:
 
             if (target_scene)
@@ -99,6 +117,14 @@ namespace basics
 
                 current_scene.reset ();
 
+                // The shared assets it no longer uses are released if they exceed the cache budget:
+
+                {
+                    Graphics_Context::Accessor context = lock_graphics_context ();
+
+                    if (context) Asset_Cache::get_instance ().trim (context);
+                }
+
                 // The new scene is then initialized:
 
                 if (target_scene->initialize ())
@@ -217,6 +243,8 @@ namespace basics
                         if (!previously_active &&  currently_active) current_scene->resume  (); else
                         if ( previously_active && !currently_active) current_scene->suspend ();
 
+                        profiler.mark (Frame_Profiler::EVENTS);
+
                         if (currently_active)
                         {
                             Size2u scene_view_size = current_scene->get_view_size ();
@@ -245,8 +273,12 @@ namespace basics
                                 current_scene->handle (event);
                             }
 
+                            profiler.mark (Frame_Profiler::HANDLE);
+
                             current_scene->update (time);
 
+                            profiler.mark (Frame_Profiler::UPDATE);
+
                             Graphics_Context::Accessor graphics_context = window->lock_graphics_context ();
 
                             if (graphics_context)
@@ -258,15 +290,27 @@ namespace basics
                                     if (canvas) canvas->reset_state ();
                                 }
 
+                                // Pending texture strips are uploaded before rendering, so the scene
+                                // sees which textures are ready in this same frame:
+
+                                graphics_context->process_uploads (upload_budget);
+
                                 current_scene->render (graphics_context);
 
+                                profiler.draw_overlay (graphics_context, scene_view_size);
+                                profiler.mark (Frame_Profiler::RENDER);
+
                                 graphics_context->flush_and_display ();
+
+                                profiler.mark (Frame_Profiler::DISPLAY);
                             }
                         }
                     }
                 }
             }
 
+            profiler.end_frame ();
+
             time = timer.get_elapsed_seconds ();
         }
         while (!kernel.exit && current_scene);
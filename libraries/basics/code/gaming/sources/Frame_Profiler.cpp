@@ -0,0 +1,153 @@
+/*
+ * FRAME PROFILER
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610171910
+ */
+
+#include <algorithm>
+#include <cwchar>
+#include <basics/Canvas>
+#include <basics/Frame_Profiler>
+#include <basics/Text_Layout>
+
+namespace basics
+{
+
+    Frame_Profiler::Frame_Profiler()
+    :
+        written(0),
+        enabled(false),
+        current{}
+    {
+    }
+
+    void Frame_Profiler::end_frame ()
+    {
+        if (enabled)
+        {
+            current.seconds[FRAME] = frame_timer.get_elapsed_seconds ();
+
+            // Solo escribe el hilo del Director. Se publica la muestra después de copiarla para que
+            // los lectores no la vean a medias:
+
+            uint32_t count = written.load (std::memory_order_relaxed);
+
+            samples[count % capacity] = current;
+
+            written.store (count + 1, std::memory_order_release);
+        }
+    }
+
+    void Frame_Profiler::copy_samples (std::vector< Sample > & copy) const
+    {
+        uint32_t end   = written.load (std::memory_order_acquire);
+        uint32_t begin = end > capacity ? end - uint32_t(capacity) : 0;
+
+        copy.clear ();
+
+        for (uint32_t index = begin; index < end; ++index)
+        {
+            copy.push_back (samples[index % capacity]);
+        }
+
+        // Si mientras se copiaba se han escrito nuevas muestras, las primeras copiadas pueden
+        // haberse sobrescrito y se descartan:
+
+        std::atomic_thread_fence (std::memory_order_acquire);
+
+        uint32_t now          = written.load (std::memory_order_relaxed);
+        uint32_t overwritten  = now - end;
+
+        copy.erase (copy.begin (), copy.begin () + std::min< size_t > (overwritten, copy.size ()));
+    }
+
+    Frame_Profiler::Statistics Frame_Profiler::get_statistics (Phase phase) const
+    {
+        std::vector< Sample > copy;
+        std::vector< float  > values;
+
+        copy_samples (copy);
+
+        Statistics statistics{};
+
+        if (copy.empty ()) return statistics;
+
+        values.reserve (copy.size ());
+
+        float total = 0.f;
+
+        for (const Sample & sample : copy)
+        {
+            values.push_back (sample.seconds[phase]);
+
+            total += sample.seconds[phase];
+        }
+
+        std::sort (values.begin (), values.end ());
+
+        // Los percentiles se calculan por rango más cercano:
+
+        auto percentile = [&values] (size_t percent)
+        {
+            size_t rank = (percent * values.size () + 99) / 100;
+
+            return values[rank > 0 ? rank - 1 : 0];
+        };
+
+        statistics.frames  = values.size ();
+        statistics.min     = values.front ();
+        statistics.average = total / float(values.size ());
+        statistics.p95     = percentile (95);
+        statistics.p99     = percentile (99);
+        statistics.max     = values.back ();
+
+        return statistics;
+    }
+
+    void Frame_Profiler::draw_overlay (Graphics_Context::Accessor & context, const Size2u & view_size) const
+    {
+        if (!enabled || !overlay_font) return;
+
+        Canvas * canvas = context->get_renderer< Canvas > (ID(canvas));
+
+        if (!canvas) return;
+
+        static const wchar_t * const names[NUMBER_OF_PHASES] =
+        {
+            L"events ", L"handle ", L"update ", L"render ", L"display", L"frame  "
+        };
+
+        float line_height = overlay_font->get_metrics ().line_height;
+        float y           = float(view_size.height) - 8.f;
+
+        canvas->set_transform (Transformation2f());
+        canvas->set_opacity   (1.f);
+
+        for (unsigned phase = 0; phase < NUMBER_OF_PHASES; ++phase, y -= line_height)
+        {
+            Statistics statistics = get_statistics (Phase(phase));
+
+            // Se muestran en milisegundos la media y los percentiles 95 y 99:
+
+            wchar_t line[64];
+
+            std::swprintf
+            (
+                line, 64, L"%ls %6.2f %6.2f %6.2f",
+                names[phase],
+                statistics.average * 1000.f,
+                statistics.p95     * 1000.f,
+                statistics.p99     * 1000.f
+            );
+
+            canvas->draw_text ({ 8.f, y }, Text_Layout(*overlay_font, line), TOP | LEFT);
+        }
+    }
+
+}
@@ -0,0 +1,111 @@
+/*
+ *  TRANSFORM POINTS
+ *  Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ *  Distributed under the Boost Software License, version  1.0
+ *  See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ *  angel.rodriguez@esne.edu
+ *
+ *  C2610171810
+ */
+
+#ifndef BASICS_TRANSFORM_POINTS_HEADER
+#define BASICS_TRANSFORM_POINTS_HEADER
+
+    #include <cstddef>
+    #include "Transformation.hpp"
+
+    #if defined(__ARM_NEON) || defined(__ARM_NEON__)
+        #include <arm_neon.h>
+        #define BASICS_TRANSFORM_POINTS_NEON
+    #elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+        #include <emmintrin.h>
+        #define BASICS_TRANSFORM_POINTS_SSE2
+    #endif
+
+    namespace basics
+    {
+
+        /**
+         * Aplica una transformación afín 2D a una secuencia de puntos intercalados con otros datos
+         * (por ejemplo, las coordenadas x e y al principio de cada vértice). Se transforman dos puntos
+         * en cada iteración con SSE2 o NEON cuando están disponibles.
+         * @param source Primer float del primer punto de origen.
+         * @param target Primer float del primer punto de destino. Puede coincidir con source.
+         * @param count Número de puntos.
+         * @param stride Distancia en floats entre dos puntos consecutivos (2 si están empaquetados).
+         */
+        inline void transform_points_2d
+        (
+            const Transformation2f & transformation,
+            const float            * source,
+                  float            * target,
+                  size_t             count,
+                  size_t             stride = 2
+        )
+        {
+            const auto & matrix = transformation.matrix;
+
+            const float a = matrix[0][0], b = matrix[0][1], c = matrix[0][2];
+            const float d = matrix[1][0], e = matrix[1][1], f = matrix[1][2];
+
+            #if defined(BASICS_TRANSFORM_POINTS_SSE2)
+
+                // Se cargan dos puntos en un registro (x0 y0 x1 y1) y se calculan las dos filas de
+                // la matriz a la vez:
+
+                const __m128 column_x    = _mm_setr_ps (a, d, a, d);
+                const __m128 column_y    = _mm_setr_ps (b, e, b, e);
+                const __m128 translation = _mm_setr_ps (c, f, c, f);
+
+                for ( ; count >= 2; count -= 2, source += stride * 2, target += stride * 2)
+                {
+                    __m128 points = _mm_setzero_ps ();
+
+                    points = _mm_loadl_pi (points, reinterpret_cast< const __m64 * >(source         ));
+                    points = _mm_loadh_pi (points, reinterpret_cast< const __m64 * >(source + stride));
+
+                    __m128 xs = _mm_shuffle_ps (points, points, _MM_SHUFFLE (2, 2, 0, 0));
+                    __m128 ys = _mm_shuffle_ps (points, points, _MM_SHUFFLE (3, 3, 1, 1));
+
+                    __m128 result = _mm_add_ps (_mm_add_ps (_mm_mul_ps (xs, column_x), _mm_mul_ps (ys, column_y)), translation);
+
+                    _mm_storel_pi (reinterpret_cast< __m64 * >(target         ), result);
+                    _mm_storeh_pi (reinterpret_cast< __m64 * >(target + stride), result);
+                }
+
+            #elif defined(BASICS_TRANSFORM_POINTS_NEON)
+
+                const float32x4_t column_x    = { a, d, a, d };
+                const float32x4_t column_y    = { b, e, b, e };
+                const float32x4_t translation = { c, f, c, f };
+
+                for ( ; count >= 2; count -= 2, source += stride * 2, target += stride * 2)
+                {
+                    float32x4_t   points = vcombine_f32 (vld1_f32 (source), vld1_f32 (source + stride));
+                    float32x4x2_t pairs  = vtrnq_f32 (points, points);      // (x0 x0 x1 x1) y (y0 y0 y1 y1)
+
+                    float32x4_t   result = vmlaq_f32 (vmlaq_f32 (translation, pairs.val[0], column_x), pairs.val[1], column_y);
+
+                    vst1_f32 (target,          vget_low_f32  (result));
+                    vst1_f32 (target + stride, vget_high_f32 (result));
+                }
+
+            #endif
+
+            // Puntos restantes (o todos si no hay instrucciones SIMD):
+
+            for ( ; count > 0; --count, source += stride, target += stride)
+            {
+                float x = source[0];
+                float y = source[1];
+
+                target[0] = a * x + b * y + c;
+                target[1] = d * x + e * y + f;
+            }
+        }
+
+    }
+
+#endif
@@ -113,6 +113,8 @@
         {
             if (available)
             {
+                flush_renderers ();
+
                 //return eglSwapBuffers (display, surface) == EGL_TRUE;
 
                 if (!eglSwapBuffers (display, surface))
@@ -14,22 +14,95 @@
 #define BASICS_OPENGLES_CANVAS_ES2_HEADER
 
     #include <memory>
+    #include <vector>
     #include <basics/Canvas>
     #include <basics/Transformation>
+    #include <basics/opengles/Render_Queue>
+    #include <basics/opengles/Render_State>
 
     namespace basics { namespace opengles
     {
 
+        class Quad_Index_Buffer;
         class Shader_Program;
+        class Stream_Buffer;
+        class Texture_2D;
 
         class Canvas_ES2 : public basics::Canvas
         {
+        private:
+
+            struct Vertex
+            {
+                float x, y;
+                float u, v;
+                float opacity;                          ///< Se multiplica por la opacidad del canvas.
+            };
+
+            typedef std::vector< Vertex > Vertex_Buffer;
+
+            /** Estado del canvas con el que se pidió cada draw guardado en la cola de ordenación. */
+            struct Draw_State
+            {
+                Transformation2f transform;
+                Vector3f         color;
+                float            opacity;
+                Blending         blending;
+
+                bool operator == (const Draw_State & other) const
+                {
+                    return
+                        transform.matrix == other.transform.matrix &&
+                        color            == other.color            &&
+                        opacity          == other.opacity          &&
+                        blending         == other.blending;
+                }
+            };
+
+            typedef Render_Queue< Vertex, Sprite_Instance, Draw_State > Draw_Queue;
+
+            /** Identificadores de shader program que se usan en la clave de ordenación. */
+            enum Program_Key
+            {
+                PROGRAM_F,
+                PROGRAM_T,
+                PROGRAM_I,
+            };
+
+            /** Valores de mezcla de la clave de ordenación. */
+            enum Blending_Key
+            {
+                OPAQUE_DRAW  = Draw_Queue::opaque_blending,
+                BLENDED_DRAW,
+            };
+
+            /** Bits que indican qué uniforms de un shader program tienen un valor pendiente de subir. */
+            enum Uniform_Bits
+            {
+                TRANSFORM_UNIFORM     = 1 << 0,
+                PROJECTION_UNIFORM    = 1 << 1,
+                COLOR_UNIFORM         = 1 << 2,
+                OPACITY_UNIFORM       = 1 << 3,
+                PREMULTIPLIED_UNIFORM = 1 << 4,
+                ALPHA_ONLY_UNIFORM    = 1 << 5,
+                ALL_UNIFORMS          = TRANSFORM_UNIFORM | PROJECTION_UNIFORM | COLOR_UNIFORM | OPACITY_UNIFORM | PREMULTIPLIED_UNIFORM | ALPHA_ONLY_UNIFORM
+            };
+
+            /** Número máximo de quads que se acumulan antes de forzar un draw call. Con índices de 16
+              * bits no se pueden direccionar más de 65536 vértices. */
+            static constexpr size_t max_batched_quads  = 2048;
+
+            /** Capacidad inicial en bytes del vertex buffer en el que se escriben los vértices. */
+            static constexpr size_t stream_buffer_size = max_batched_quads * 4 * sizeof(Vertex) * 4;
+
         private:
 
             static const char * internal_vertex_shader_f;
             static const char * internal_vertex_shader_t;
             static const char * internal_fragment_shader_f;
             static const char * internal_fragment_shader_t;
+            static const char * internal_vertex_shader_i;
+            static const char * internal_fragment_shader_i;
 
         public:
 
@@ -49,22 +122,85 @@
 
             Transformation2f transform;
             Transformation2f projection;
+            Vector3f         color;
+            float            opacity;
+            Blending         blending;
+            bool             premultiplied;     ///< Valor del uniform premultiplied de los shader programs con textura.
+            bool             alpha_only;        ///< Valor del uniform alpha_only de los shader programs con textura.
+
+            Render_State     render_state;
 
-            std::shared_ptr< Shader_Program > shader_program_f;
-            std::shared_ptr< Shader_Program > shader_program_t;
+            unsigned   dirty_uniforms_f;                ///< Uniforms de shader_program_f que no están al día.
+            unsigned   dirty_uniforms_t;                ///< Uniforms de shader_program_t que no están al día.
+            unsigned   dirty_uniforms_i;                ///< Uniforms de shader_program_i que no están al día.
 
-            int  transform_f_id;
-            int projection_f_id;
-            int      color_f_id;
-            int    opacity_f_id;
-            int  transform_t_id;
-            int projection_t_id;
-            int    sampler_t_id;
-            int    opacity_t_id;
+            std::shared_ptr< Shader_Program    > shader_program_f;
+            std::shared_ptr< Shader_Program    > shader_program_t;
+            std::shared_ptr< Shader_Program    > shader_program_i;
+            std::shared_ptr< Stream_Buffer     > vertex_stream;
+            std::shared_ptr< Quad_Index_Buffer > quad_indices;
+
+            int     transform_f_id;
+            int    projection_f_id;
+            int         color_f_id;
+            int       opacity_f_id;
+            int     transform_t_id;
+            int    projection_t_id;
+            int       sampler_t_id;
+            int       opacity_t_id;
+            int premultiplied_t_id;
+            int         color_t_id;
+            int    alpha_only_t_id;
+            int     transform_i_id;
+            int    projection_i_id;
+            int       sampler_i_id;
+            int premultiplied_i_id;
+            int         color_i_id;
+            int    alpha_only_i_id;
 
             unsigned   vertex_position_location_f;
             unsigned   vertex_position_location_t;
             unsigned vertex_texture_uv_location_t;
+            unsigned   vertex_opacity_location_t;
+            unsigned     vertex_corner_location_i;
+            unsigned      instance_rect_location_i;
+            unsigned       instance_uvs_location_i;
+            unsigned   instance_opacity_location_i;
+
+            struct
+            {
+                bool               enabled;
+                const Texture_2D * texture;
+                Vertex_Buffer      vertices;
+            }
+            batch;
+
+            struct
+            {
+                bool                              available;
+                bool                              enabled;
+                PFNGLDRAWELEMENTSINSTANCEDEXTPROC draw_elements_instanced;
+                PFNGLVERTEXATTRIBDIVISOREXTPROC   vertex_attrib_divisor;
+                std::vector< float >              data;
+            }
+            instancing;
+
+            struct
+            {
+                bool               enabled;
+                bool               submitting;      ///< Se está enviando la cola (los draws no se encolan).
+                int                layer;
+                float              depth;
+                Draw_Queue         queue;
+            }
+            sorting;
+
+            struct
+            {
+                bool               enabled;
+                Vertex_Buffer      vertices;        ///< Vértices ya transformados que se van a dibujar.
+            }
+            pre_transform;
 
         public:
 
@@ -73,6 +209,51 @@
         public:
 
             void reset_state     () override;
+            void flush           () override;
+
+        public:
+
+            /**
+             * Activa o desactiva la agrupación de quads con textura. Mientras está activa, los quads
+             * consecutivos que usan la misma textura se acumulan y se dibujan con un único draw call
+             * cuando cambia la textura, la opacidad o la transformación, o cuando se presenta el frame.
+             * Está activa por defecto.
+             */
+            void set_batching    (bool enabled);
+
+            bool is_batching     () const
+            {
+                return batch.enabled;
+            }
+
+            /**
+             * Activa o desactiva el uso de GL_EXT_instanced_arrays (o GL_ANGLE_instanced_arrays) en
+             * draw_sprites(). Si está desactivado o el driver no ofrece la extensión, las instancias
+             * se expanden a quads en la CPU y se añaden al lote de quads con textura.
+             */
+            void set_instancing  (bool enabled)
+            {
+                instancing.enabled = enabled;
+            }
+
+            bool is_instancing   () const
+            {
+                return instancing.enabled && instancing.available;
+            }
+
+            /**
+             * Activa o desactiva la transformación de los vértices en la CPU. Mientras está activa,
+             * la transformación actual se aplica a los vértices de los quads y de las primitivas al
+             * añadirlos al lote, los shader programs reciben la identidad como transformación y
+             * set_transform() no obliga a dibujar lo acumulado. Las instancias de draw_sprites() se
+             * siguen transformando en el vertex shader. Está activa por defecto.
+             */
+            void set_pre_transform (bool enabled);
+
+            bool is_pre_transform  () const
+            {
+                return pre_transform.enabled;
+            }
 
         public:
 
@@ -83,9 +264,40 @@
             void set_clear_color (float r, float g, float b) override;
             void set_color       (float r, float g, float b) override;
             void set_opacity     (float opacity) override;
+
+            float get_opacity    () const override
+            {
+                return opacity;
+            }
+
+            /**
+             * Cambia la forma en que se mezclan los draws siguientes con lo que hay debajo. Con las
+             * texturas que tienen el alfa premultiplicado se usa la función de mezcla equivalente
+             * (GL_ONE, GL_ONE_MINUS_SRC_ALPHA en lugar de GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA con
+             * TRANSPARENCY). Por defecto se usa TRANSPARENCY.
+             */
+            void set_blending    (Blending blending) override;
             void set_transform   (const Transformation2f & transform) override;
             void apply_transform (const Transformation2f & transform) override;
 
+            /**
+             * Mientras la ordenación está activa los draws no se envían a OpenGL, sino que se guardan
+             * en una cola junto con la capa y la profundidad actuales, el estado del canvas y el
+             * rectángulo que ocupan. Al hacer flush() (o clear(), o al desactivarla) la cola se ordena
+             * de forma estable por capa y profundidad. Dentro de cada capa se envían primero los draws
+             * opacos que no se solapan con draws anteriores con mezcla, y un draw solo se adelanta
+             * para juntarse con otro que usa la misma mezcla, shader program y textura si no se solapa
+             * con los draws que salta (ver Render_Queue). Las instancias de draw_sprites() se guardan
+             * como un draw instanciado por textura.
+             */
+            void set_sorting     (bool enabled) override;
+            void set_layer       (int layer, float depth = 0.f) override;
+
+            bool is_sorting      () const
+            {
+                return sorting.enabled;
+            }
+
         public:
 
             void clear           () override;
@@ -98,6 +310,71 @@
             void fill_rectangle  (const Point2f & where, const Size2f & size, const basics::Texture_2D * texture, int handling = CENTER) override;
             void fill_rectangle  (const Point2f & where, const Size2f & size, const Atlas::Slice * slice, int handling = CENTER) override;
 
+            using Canvas::draw_sprites;
+
+            void draw_sprites    (const Sprite_Instance * instances, size_t count) override;
+
+        private:
+
+            void invalidate_uniforms (unsigned uniform_bits)
+            {
+                dirty_uniforms_f |= uniform_bits;
+                dirty_uniforms_t |= uniform_bits;
+                dirty_uniforms_i |= uniform_bits;
+            }
+
+            void set_premultiplied   (bool premultiplied);
+            void set_alpha_only      (bool alpha_only);
+            void apply_blending      (bool translucent, bool premultiplied_source);
+
+            /** Indica si algún vértice tiene una opacidad menor que 1. */
+            static bool any_translucent (const Vertex * vertices, size_t number_of_vertices)
+            {
+                for (const Vertex * end = vertices + number_of_vertices; vertices < end; ++vertices)
+                {
+                    if (vertices->opacity < 1.f) return true;
+                }
+
+                return false;
+            }
+
+            /** Valor de mezcla de la clave de ordenación de un draw. */
+            unsigned blending_key    (bool opaque) const
+            {
+                return blending == NONE || (blending == TRANSPARENCY && opaque && opacity == 1.f) ? OPAQUE_DRAW : BLENDED_DRAW;
+            }
+
+            void use_program_f       ();
+            void use_program_t       ();
+            void use_program_i       ();
+
+            void detect_instancing   ();
+
+            const Vertex * transform_vertices (const Vertex * vertices, size_t number_of_vertices);
+
+            /** Transformación que reciben los shader programs que no dibujan instancias. */
+            const Transformation2f::Matrix & shader_transform () const
+            {
+                return pre_transform.enabled ? Transformation2f::Matrix::identity : transform.matrix;
+            }
+
+            void flush_batch         ();
+            void submit_queue        ();
+
+            void fill_slice          (const Point2f & where, const Size2f & size, const Atlas::Slice * slice, int handling, float slice_opacity);
+            void fill_textured_quad  (const Texture_2D * texture, const Point2f & bottom_left, const Size2f & size, const Point2f * texture_uvs, float quad_opacity = 1.f);
+            void add_textured_quads  (const Texture_2D * texture, const Vertex * vertices, size_t number_of_quads);
+            void draw_textured_quads (const Texture_2D * texture, const Vertex * vertices, size_t number_of_quads);
+            void draw_primitive      (unsigned mode, const Point2f * points, size_t number_of_points);
+            void draw_untextured     (unsigned mode, const Vertex  * vertices, size_t number_of_vertices);
+            void draw_instances      (const Texture_2D * texture, size_t number_of_instances);
+            void queue_instances     (const Sprite_Instance * instances, size_t count);
+            void draw_instanced      (const Sprite_Instance * instances, size_t count);
+
+            /** Rectángulo que ocupa en el canvas el rectángulo indicado una vez transformado. */
+            Draw_Queue::Bounds transformed_bounds (float left, float bottom, float right, float top) const;
+            Draw_Queue::Bounds transformed_bounds (const Vertex * vertices, size_t number_of_vertices) const;
+
         };
 
     }}
@@ -0,0 +1,92 @@
+/*
+ * QUAD INDEX BUFFER
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version 1.0
+ * See the LICENSE file or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610171135
+ */
+
+#ifndef BASICS_OPENGLES_QUAD_INDEX_BUFFER_HEADER
+#define BASICS_OPENGLES_QUAD_INDEX_BUFFER_HEADER
+
+    #include <cstddef>
+    #include <basics/Graphics_Resource>
+    #include <basics/opengles/OpenGL_ES2>
+
+    namespace basics { namespace opengles
+    {
+
+        /**
+         * Index buffer estático con los índices de una secuencia de quads. Cada quad se compone de
+         * cuatro vértices consecutivos en el orden de un triangle strip (abajo-izquierda,
+         * arriba-izquierda, abajo-derecha, arriba-derecha) y se dibuja como dos triángulos.
+         */
+        class Quad_Index_Buffer : public Graphics_Resource
+        {
+        public:
+
+            /** Con índices de 16 bits no se pueden direccionar más de 65536 vértices. */
+            static constexpr size_t max_quads = 65536 / 4;
+
+        private:
+
+            GLuint buffer_object_id;
+            size_t number_of_quads;
+
+        public:
+
+            Quad_Index_Buffer(size_t number_of_quads)
+            :
+                buffer_object_id(0),
+                number_of_quads (number_of_quads < max_quads ? number_of_quads : max_quads)
+            {
+            }
+
+            Quad_Index_Buffer(const Quad_Index_Buffer & ) = delete;
+
+           ~Quad_Index_Buffer()
+            {
+                finalize ();
+            }
+
+        public:
+
+            bool initialize () override;
+            void finalize   () override;
+
+        public:
+
+            bool is_usable () const
+            {
+                return initialized;
+            }
+
+            size_t get_number_of_quads () const
+            {
+                return number_of_quads;
+            }
+
+            void bind () const
+            {
+                glBindBuffer (GL_ELEMENT_ARRAY_BUFFER, buffer_object_id);
+            }
+
+            /**
+             * Dibuja quads cuyos vértices ya están enlazados como atributos (el buffer debe estar
+             * enlazado a GL_ELEMENT_ARRAY_BUFFER).
+             * @param count Número de quads que se deben dibujar.
+             */
+            void draw (size_t count) const
+            {
+                glDrawElements (GL_TRIANGLES, GLsizei(count * 6), GL_UNSIGNED_SHORT, nullptr);
+            }
+
+        };
+
+    }}
+
+#endif
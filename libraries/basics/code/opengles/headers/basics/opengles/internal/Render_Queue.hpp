@@ -0,0 +1,311 @@
+/*
+ * RENDER QUEUE
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version 1.0
+ * See the LICENSE file or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610171720
+ */
+
+#ifndef BASICS_OPENGLES_RENDER_QUEUE_HEADER
+#define BASICS_OPENGLES_RENDER_QUEUE_HEADER
+
+    #include <algorithm>
+    #include <cstdint>
+    #include <vector>
+
+    namespace basics { namespace opengles
+    {
+
+        /**
+         * Cola de draw calls diferidos. Cada draw se etiqueta con una clave (capa, profundidad, modo de
+         * mezcla, shader program y textura) y guarda sus vértices (o sus instancias), el estado con el
+         * que se pidió y el rectángulo que ocupa en pantalla.
+         * Al enviarla se ordena de forma estable por capa y profundidad. Cada capa se envía en dos
+         * pasadas: primero los draws opacos (mezcla opaque_blending) que no se solapan con ninguno de
+         * los draws anteriores que quedan para la segunda pasada, y después el resto. Dentro de cada
+         * pasada un draw solo se adelanta para juntarse con el último que comparte con él mezcla,
+         * shader program y textura cuando no se solapa con ninguno de los draws que salta, de modo
+         * que se reducen los cambios de estado sin alterar el resultado visual.
+         * Como no hay buffer de profundidad, los draws opacos se envían en el orden en que se
+         * pidieron (de atrás hacia delante) y no de delante hacia atrás.
+         * @tparam VERTEX Tipo de los vértices.
+         * @tparam INSTANCE Tipo de las instancias de los draws instanciados.
+         * @tparam STATE Estado asociado a cada draw (transformación, opacidad...). Debe tener operator==.
+         */
+        template< class VERTEX, class INSTANCE, class STATE >
+        class Render_Queue
+        {
+        public:
+
+            struct Key
+            {
+                int          layer;
+                float        depth;
+                unsigned     program;
+                const void * texture;
+                unsigned     blending;
+
+                bool same_layer (const Key & other) const
+                {
+                    return layer == other.layer && depth == other.depth;
+                }
+
+                bool same_state (const Key & other) const
+                {
+                    return program == other.program && texture == other.texture && blending == other.blending;
+                }
+            };
+
+            /** Rectángulo que ocupa un draw en coordenadas del canvas. */
+            struct Bounds
+            {
+                float left, bottom, right, top;
+
+                bool overlaps (const Bounds & other) const
+                {
+                    return left <= other.right && other.left <= right && bottom <= other.top && other.bottom <= top;
+                }
+
+                void merge (const Bounds & other)
+                {
+                    left   = std::min (left,   other.left  );
+                    bottom = std::min (bottom, other.bottom);
+                    right  = std::max (right,  other.right );
+                    top    = std::max (top,    other.top   );
+                }
+            };
+
+            struct Command
+            {
+                Key      key;
+                Bounds   bounds;
+                uint32_t state;
+                uint32_t first;                     ///< Primer vértice o primera instancia.
+                uint32_t count;                     ///< Número de vértices o de instancias.
+                unsigned mode;
+                bool     instanced;
+            };
+
+            /** Número máximo de grupos que un draw puede saltar para juntarse con otro. */
+            static const size_t max_merge_distance = 16;
+
+            /** Valor de Key::blending de los draws que tapan por completo lo que hay debajo. */
+            static const unsigned opaque_blending = 0;
+
+        private:
+
+            /** Secuencia de draws con el mismo estado que se envían seguidos. */
+            struct Group
+            {
+                uint32_t first_command;
+                uint32_t last_command;
+                Bounds   bounds;
+            };
+
+            std::vector< Command  > commands;
+            std::vector< VERTEX   > vertices;
+            std::vector< INSTANCE > instances;
+            std::vector< STATE    > states;
+            std::vector< Group    > groups;
+            std::vector< uint32_t > next_command;
+            std::vector< uint8_t  > early_pass;
+            std::vector< Bounds   > late_bounds;
+
+        public:
+
+            bool empty () const
+            {
+                return commands.empty ();
+            }
+
+            size_t size () const
+            {
+                return commands.size ();
+            }
+
+            /**
+             * Añade un draw a la cola.
+             * @param mode Tipo de primitiva con el que se deben interpretar los vértices.
+             * @param bounds Rectángulo que ocupa el draw una vez transformado.
+             */
+            void push (const Key & key, const STATE & state, const Bounds & bounds, unsigned mode, const VERTEX * first, size_t count)
+            {
+                commands.push_back ({ key, bounds, push_state (state), uint32_t(vertices.size ()), uint32_t(count), mode, false });
+
+                vertices.insert (vertices.end (), first, first + count);
+            }
+
+            /**
+             * Añade un draw instanciado a la cola.
+             * @param bounds Rectángulo que ocupan todas las instancias una vez transformadas.
+             */
+            void push_instances (const Key & key, const STATE & state, const Bounds & bounds, const INSTANCE * first, size_t count)
+            {
+                commands.push_back ({ key, bounds, push_state (state), uint32_t(instances.size ()), uint32_t(count), 0, true });
+
+                instances.insert (instances.end (), first, first + count);
+            }
+
+            /**
+             * Ordena la cola y llama a submit_function (command, state, vertices, instances) con cada
+             * draw. Según el tipo de draw uno de los dos punteros es nulo. Al terminar la cola queda
+             * vacía.
+             */
+            template< typename SUBMIT_FUNCTION >
+            void submit (SUBMIT_FUNCTION submit_function)
+            {
+                std::stable_sort
+                (
+                    commands.begin (),
+                    commands.end   (),
+                    [] (const Command & a, const Command & b)
+                    {
+                        return a.key.layer != b.key.layer ? a.key.layer < b.key.layer : a.key.depth < b.key.depth;
+                    }
+                );
+
+                next_command.assign (commands.size (), uint32_t(commands.size ()));
+                early_pass  .assign (commands.size (), 0);
+
+                for (size_t first = 0, end = commands.size (); first < end; )
+                {
+                    size_t last = first + 1;
+
+                    while (last < end && commands[last].key.same_layer (commands[first].key)) ++last;
+
+                    select_early_pass (first, last);
+
+                    group_layer   (first, last, 1);
+                    submit_groups (submit_function);
+
+                    group_layer   (first, last, 0);
+                    submit_groups (submit_function);
+
+                    first = last;
+                }
+
+                clear ();
+            }
+
+            void clear ()
+            {
+                commands .clear ();
+                vertices .clear ();
+                instances.clear ();
+                states   .clear ();
+            }
+
+        private:
+
+            uint32_t push_state (const STATE & state)
+            {
+                // Los draws consecutivos con el mismo estado lo comparten:
+
+                if (states.empty () || !(states.back () == state))
+                {
+                    states.push_back (state);
+                }
+
+                return uint32_t(states.size () - 1);
+            }
+
+            /**
+             * Marca los draws [first, last) de una misma capa que pueden enviarse en la pasada de
+             * opacos: los que no mezclan y no se solapan con ninguno de los draws anteriores que se
+             * quedan en la segunda pasada (y que por tanto deberían quedar debajo).
+             */
+            void select_early_pass (size_t first, size_t last)
+            {
+                late_bounds.clear ();
+
+                for (size_t index = first; index < last; ++index)
+                {
+                    const Command & command = commands[index];
+
+                    bool early = command.key.blending == opaque_blending;
+
+                    for (size_t other = 0; early && other < late_bounds.size (); ++other)
+                    {
+                        if (late_bounds[other].overlaps (command.bounds)) early = false;
+                    }
+
+                    if (early)
+                        early_pass[index] = 1;
+                    else
+                        late_bounds.push_back (command.bounds);
+                }
+            }
+
+            /**
+             * Reparte en grupos los draws [first, last) de una misma capa que pertenecen a la pasada
+             * indicada. Cada draw se añade al último grupo con su mismo estado si no se solapa con
+             * ninguno de los grupos posteriores a ese. En caso contrario empieza un grupo nuevo al
+             * final.
+             */
+            void group_layer (size_t first, size_t last, uint8_t pass)
+            {
+                groups.clear ();
+
+                for (size_t index = first; index < last; ++index)
+                {
+                    if (early_pass[index] != pass) continue;
+
+                    const Command & command = commands[index];
+
+                    Group * target = nullptr;
+
+                    for (size_t distance = 0; distance < groups.size () && distance < max_merge_distance; ++distance)
+                    {
+                        Group & group = groups[groups.size () - 1 - distance];
+
+                        if (commands[group.first_command].key.same_state (command.key))
+                        {
+                            target = &group;
+                            break;
+                        }
+
+                        if (group.bounds.overlaps (command.bounds)) break;
+                    }
+
+                    if (target)
+                    {
+                        next_command[target->last_command] = uint32_t(index);
+                        target->last_command = uint32_t(index);
+                        target->bounds.merge (command.bounds);
+                    }
+                    else
+                        groups.push_back ({ uint32_t(index), uint32_t(index), command.bounds });
+                }
+            }
+
+            template< typename SUBMIT_FUNCTION >
+            void submit_groups (SUBMIT_FUNCTION & submit_function)
+            {
+                const uint32_t end = uint32_t(commands.size ());
+
+                for (const Group & group : groups)
+                {
+                    for (uint32_t index = group.first_command; index < end; index = next_command[index])
+                    {
+                        const Command & command = commands[index];
+
+                        submit_function
+                        (
+                            command,
+                            states[command.state],
+                            command.instanced ? nullptr : vertices .data () + command.first,
+                            command.instanced ? instances.data () + command.first : nullptr
+                        );
+                    }
+                }
+            }
+
+        };
+
+    }}
+
+#endif
@@ -0,0 +1,91 @@
+/*
+ * RENDER STATE
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version 1.0
+ * See the LICENSE file or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610171320
+ */
+
+#ifndef BASICS_OPENGLES_RENDER_STATE_HEADER
+#define BASICS_OPENGLES_RENDER_STATE_HEADER
+
+    #include <cstdint>
+    #include <basics/opengles/OpenGL_ES2>
+
+    namespace basics { namespace opengles
+    {
+
+        /**
+         * Copia en memoria del estado de OpenGL ES que cambia entre draw calls. Permite evitar las
+         * llamadas que no modificarían nada: cambiar al shader program o a la textura que ya están en
+         * uso, volver a habilitar atributos de vértice habilitados o volver a fijar el mismo modo de
+         * mezcla.
+         * El shader program y la textura activos los siguen Shader_Program::use() y Texture_2D::use(),
+         * que ya descartan los cambios redundantes, e invalidate() los olvida junto con el resto.
+         */
+        class Render_State
+        {
+        public:
+
+            struct Blend_Function
+            {
+                GLenum source;
+                GLenum destination;
+
+                bool operator == (const Blend_Function & other) const
+                {
+                    return source == other.source && destination == other.destination;
+                }
+            };
+
+        private:
+
+            /** Valor que no coincide con ninguna función de mezcla real, de modo que la primera que se
+              * fije se envíe siempre a OpenGL ES. */
+            static constexpr Blend_Function unknown_blend_function = { GLenum(-1), GLenum(-1) };
+
+        private:
+
+            uint32_t       enabled_attributes;
+            bool           blending_known;
+            bool           blending_enabled;
+            Blend_Function blend_function;
+
+        public:
+
+            Render_State()
+            :
+                enabled_attributes(0),
+                blending_known    (false),
+                blending_enabled  (false),
+                blend_function    (unknown_blend_function)
+            {
+            }
+
+        public:
+
+            /**
+             * Olvida el estado conocido. Se debe llamar cuando algo ajeno ha podido cambiar el estado
+             * de OpenGL ES (por ejemplo, tras crearse de nuevo el contexto).
+             */
+            void invalidate ();
+
+        public:
+
+            /**
+             * Deja habilitados exactamente los atributos de vértice indicados.
+             * @param mask Máscara con un bit a 1 por cada location de atributo que se debe habilitar.
+             */
+            void enable_vertex_attributes (uint32_t mask);
+
+            void set_blending (bool enabled, const Blend_Function & function = { GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA });
+
+        };
+
+    }}
+
+#endif
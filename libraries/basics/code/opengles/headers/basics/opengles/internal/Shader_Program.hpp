@@ -45,6 +45,8 @@
             static void disable ()
             {
                 glUseProgram (0);
+
+                active_shader_program = nullptr;
             }
 
         private:
@@ -77,7 +79,11 @@
             {
                 if (initialized)
                 {
+                    if (active_shader_program == this) active_shader_program = nullptr;
+
                     glDeleteProgram (program_object_id);
+
+                    initialized = false;
                 }
             }
 
@@ -0,0 +1,100 @@
+/*
+ * STREAM BUFFER
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version 1.0
+ * See the LICENSE file or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610171130
+ */
+
+#ifndef BASICS_OPENGLES_STREAM_BUFFER_HEADER
+#define BASICS_OPENGLES_STREAM_BUFFER_HEADER
+
+    #include <cstddef>
+    #include <basics/Graphics_Resource>
+    #include <basics/opengles/OpenGL_ES2>
+
+    namespace basics { namespace opengles
+    {
+
+        /**
+         * Vertex buffer object en el que se escriben los vértices que cambian en cada frame.
+         * Al empezar cada frame (y si en un frame se llena) se descarta el almacenamiento anterior
+         * (orphaning) para que el driver no tenga que esperar a que la GPU termine de leerlo. Entre
+         * tanto, cada escritura ocupa la siguiente porción libre y nunca se vuelve a escribir sobre
+         * una porción que la GPU pueda estar leyendo.
+         */
+        class Stream_Buffer : public Graphics_Resource
+        {
+        private:
+
+            GLuint     buffer_object_id;
+            GLsizeiptr capacity;
+            GLintptr   offset;
+
+        public:
+
+            Stream_Buffer(size_t capacity)
+            :
+                buffer_object_id(0),
+                capacity(GLsizeiptr(capacity)),
+                offset  (0)
+            {
+            }
+
+            Stream_Buffer(const Stream_Buffer & ) = delete;
+
+           ~Stream_Buffer()
+            {
+                finalize ();
+            }
+
+        public:
+
+            bool initialize () override;
+            void finalize   () override;
+
+        public:
+
+            bool is_usable () const
+            {
+                return initialized;
+            }
+
+            size_t get_capacity () const
+            {
+                return size_t(capacity);
+            }
+
+            void bind () const
+            {
+                glBindBuffer (GL_ARRAY_BUFFER, buffer_object_id);
+            }
+
+            /**
+             * Copia datos al buffer (que queda enlazado a GL_ARRAY_BUFFER).
+             * @param data Datos que se deben copiar.
+             * @param size Número de bytes que se deben copiar.
+             * @return Offset en bytes dentro del buffer en el que se han copiado los datos.
+             */
+            size_t write (const void * data, size_t size);
+
+            /**
+             * Descarta el almacenamiento actual y hace que la siguiente escritura empiece desde el
+             * principio de uno nuevo. No hace nada si no se ha escrito nada desde la última vez.
+             */
+            void orphan ();
+
+        private:
+
+            /** Reserva un almacenamiento nuevo de la capacidad actual (queda enlazado). */
+            void allocate ();
+
+        };
+
+    }}
+
+#endif
@@ -26,33 +26,73 @@
 
             static const Texture_2D * active_texture;
 
+            /** Bytes aproximados de cada franja que sube continue_upload(). */
+            static constexpr unsigned strip_size = 256 * 1024;
+
         public:
 
-            static std::shared_ptr< basics::Texture_2D > create (Id id, Color_Buffer< Rgba8888 > & color_buffer, const Options & options = {});
+            static std::shared_ptr< basics::Texture_2D > create            (Id id, Color_Buffer< Rgba8888 > & color_buffer,     const Options & options = {});
+            static std::shared_ptr< basics::Texture_2D > create_compressed (Id id, Compressed_Image         & compressed_image, const Options & options = {});
+
+            /** Indica si el contexto actual admite el formato de compresión indicado. */
+            static bool supports (Compressed_Image::Format format);
 
         public:
 
             static void enable ()
             {
-                register_factory (ID(opengles2), basics::opengles::Texture_2D::create);
+                register_factory (ID(opengles2), basics::opengles::Texture_2D::create, basics::opengles::Texture_2D::create_compressed);
             }
 
             static void unuse ()
             {
                 glBindTexture (GL_TEXTURE_2D, 0);
+
+                active_texture = nullptr;
             }
 
         private:
 
             Color_Buffer< Rgba8888 > color_buffer;
+            Compressed_Image         compressed_image;          ///< Solo se usa si la textura está comprimida.
+            Format                   format;
+            bool                     dither;
+            Filter                   filter;
+            bool                     mipmaps;
             GLuint texture_object_id;
 
+            struct
+            {
+                bool     enabled;
+                unsigned next_row;                  ///< Primera fila de la imagen que falta por subir.
+                bool     mipmaps;                   ///< Generar los mipmaps al terminar.
+                bool     power_of_two;
+            }
+            staging;
+
         public:
 
-            Texture_2D(const Color_Buffer< Rgba8888 > & color_buffer, unsigned width, unsigned height)
+            Texture_2D(Color_Buffer< Rgba8888 > color_buffer, const Options & options)
             :
-                basics::Texture_2D(width, height),
-                color_buffer      (color_buffer )
+                basics::Texture_2D(options.width, options.height, options.opaque, options.premultiplied),
+                color_buffer      (std::move (color_buffer)),
+                format            (options.format == RGB565 && !options.opaque ? RGBA8888 : options.format),
+                dither            (options.dither ),
+                filter            (options.filter ),
+                mipmaps           (options.mipmaps),
+                staging           { options.staged, 0, false, false }
+            {
+            }
+
+            Texture_2D(Compressed_Image compressed_image, const Options & options)
+            :
+                basics::Texture_2D(compressed_image.width, compressed_image.height, true, options.premultiplied),
+                compressed_image  (std::move (compressed_image)),
+                format            (RGBA8888        ),
+                dither            (false           ),
+                filter            (options.filter  ),
+                mipmaps           (options.mipmaps ),
+                staging           { false, 0, false, false }
             {
             }
 
@@ -65,6 +105,10 @@
                 finalize ();
             }
 
+        public:
+
+            size_t get_memory_size () const override;
+
         public:
 
             bool initialize () override;
@@ -73,7 +117,12 @@
             {
                 if (initialized)
                 {
+                    if (active_texture == this) active_texture = nullptr;
+
                     glDeleteTextures (1, &texture_object_id);
+
+                    initialized      = false;
+                    staging.next_row = 0;
                 }
             }
 
@@ -84,10 +133,37 @@
                 return initialized;
             }
 
+            /**
+             * Las texturas creadas con Options::staged quedan inicializadas con la memoria reservada,
+             * pero no están listas hasta que continue_upload() ha subido todas sus franjas.
+             */
+            bool is_ready () const override
+            {
+                return initialized && !(staging.enabled && staging.next_row < unsigned(height));
+            }
+
+            bool continue_upload (float budget_seconds) override;
+
         public:
 
             bool use () const;
 
+            /** Indica si la textura solo guarda el alfa (A8), por lo que su color es el del canvas. */
+            bool is_alpha_only () const
+            {
+                return format == A8;
+            }
+
+        private:
+
+            static bool has_extension (const char * name);
+
+            void transfer_format   (GLenum & gl_format, GLenum & gl_type) const;
+            void allocate          ();
+            void upload            (GLint level, const Color_Buffer< Rgba8888 > & pixels);
+            void upload            (GLint level, const Rgba8888 * pixels, unsigned width, unsigned height, GLint first_row = -1);
+            void generate_mipmaps  (bool power_of_two);
+
         };
 
     }}
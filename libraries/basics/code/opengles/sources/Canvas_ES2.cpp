@@ -10,10 +10,16 @@
  * C1801091703
  */
 
+#include <algorithm>
+#include <cstring>
+#include <EGL/egl.h>
 #include <basics/Transformation>
+#include <basics/Transform_Points>
 #include <basics/opengles/OpenGL_ES2>
 #include <basics/opengles/Canvas_ES2>
+#include <basics/opengles/Quad_Index_Buffer>
 #include <basics/opengles/Shader_Program>
+#include <basics/opengles/Stream_Buffer>
 #include <basics/opengles/Texture_2D>
 
 // glTexCoordPointer (2, GL_FLOAT, 0, tex_coords);
@@ -36,12 +42,15 @@ namespace basics { namespace opengles
         "uniform   mat3 transform;"
         "uniform   mat3 projection;"
         "attribute vec2 vertex_position;"
-        "attribute vec2 vertex_texture_uv;"
-        "varying   vec2 varying_uv;"
+        "attribute vec2  vertex_texture_uv;"
+        "attribute float vertex_opacity;"
+        "varying   vec2  varying_uv;"
+        "varying   float varying_opacity;"
         "void main()"
         "{"
-            "varying_uv  = vertex_texture_uv;"
-            "gl_Position = vec4((vec3(vertex_position, 1.0) * transform * projection).xy, 0.0, 1.0);"
+            "varying_uv      = vertex_texture_uv;"
+            "varying_opacity = vertex_opacity;"
+            "gl_Position     = vec4((vec3(vertex_position, 1.0) * transform * projection).xy, 0.0, 1.0);"
         "}";
 
     const char * Canvas_ES2::internal_fragment_shader_f =
@@ -57,13 +66,89 @@ namespace basics { namespace opengles
         "precision mediump   float;"
         "uniform   sampler2D sampler;"
         "uniform   float     opacity;"
+        "uniform   float     premultiplied;"
+        "uniform   vec3      color;"
+        "uniform   float     alpha_only;"
         "varying   vec2      varying_uv;"
+        "varying   float     varying_opacity;"
+        "void main()"
+        "{"
+            "float alpha  = opacity * varying_opacity;"
+            "vec4  texel  = texture2D (sampler, varying_uv);"
+            "texel.rgb    = mix (texel.rgb, color * mix (1.0, texel.a, premultiplied), alpha_only);"
+            "gl_FragColor = vec4(texel.rgb * mix (1.0, alpha, premultiplied), texel.a * alpha);"
+        "}";
+
+    const char * Canvas_ES2::internal_vertex_shader_i =
+        "precision mediump float;"
+        "uniform   mat3  transform;"
+        "uniform   mat3  projection;"
+        "attribute vec2  vertex_corner;"
+        "attribute vec4  instance_rectangle;"
+        "attribute vec4  instance_texture_uvs;"
+        "attribute float instance_opacity;"
+        "varying   vec2  varying_uv;"
+        "varying   float varying_opacity;"
+        "void main()"
+        "{"
+            "vec2 position  = instance_rectangle.xy + vertex_corner * instance_rectangle.zw;"
+            "varying_uv      = mix (instance_texture_uvs.xy, instance_texture_uvs.zw, vertex_corner);"
+            "varying_opacity = instance_opacity;"
+            "gl_Position     = vec4((vec3(position, 1.0) * transform * projection).xy, 0.0, 1.0);"
+        "}";
+
+    const char * Canvas_ES2::internal_fragment_shader_i =
+        "precision mediump   float;"
+        "uniform   sampler2D sampler;"
+        "uniform   float     premultiplied;"
+        "uniform   vec3      color;"
+        "uniform   float     alpha_only;"
+        "varying   vec2      varying_uv;"
+        "varying   float     varying_opacity;"
         "void main()"
         "{"
             "vec4 texel   = texture2D (sampler, varying_uv);"
-            "gl_FragColor = vec4(texel.rgb, texel.a * opacity);"
+            "texel.rgb    = mix (texel.rgb, color * mix (1.0, texel.a, premultiplied), alpha_only);"
+            "gl_FragColor = vec4(texel.rgb * mix (1.0, varying_opacity, premultiplied), texel.a * varying_opacity);"
         "}";
 
+    // Esquinas del quad unidad que se expande para cada instancia, en el orden que espera
+    // Quad_Index_Buffer (inferior izquierda, superior izquierda, inferior derecha, superior derecha):
+
+    static const float instance_corners[] =
+    {
+        0.f, 0.f,
+        0.f, 1.f,
+        1.f, 0.f,
+        1.f, 1.f,
+    };
+
+    static const size_t instance_stride = 9;            // rectángulo (4), coordenadas de textura (4) y opacidad (1)
+
+    // Esquina inferior izquierda del rectángulo de una instancia según su anclaje:
+
+    static Point2f instance_bottom_left (const Sprite_Instance & instance)
+    {
+        const Point2f & where  = instance.position;
+        const Size2f  & size   = instance.size;
+              float     left   = where[0] - size[0] * 0.5f;
+              float     bottom = where[1] - size[1] * 0.5f;
+
+        switch (instance.handling & 0x03)
+        {
+            case LEFT:   left   = where[0];           break;
+            case RIGHT:  left   = where[0] - size[0]; break;
+        }
+
+        switch (instance.handling & 0x0C)
+        {
+            case TOP:    bottom = where[1] - size[1]; break;
+            case BOTTOM: bottom = where[1];           break;
+        }
+
+        return { left, bottom };
+    }
+
     static const Point2f normal_texture_uvs[] =
     {
         { 0.f, 1.f },
@@ -109,6 +194,28 @@ namespace basics { namespace opengles
     :
         size{ float(size.width), float(size.height) }
     {
+        dirty_uniforms_f = ALL_UNIFORMS;
+        dirty_uniforms_t = ALL_UNIFORMS;
+        dirty_uniforms_i = ALL_UNIFORMS;
+
+        batch.enabled = true;
+        batch.texture = nullptr;
+        batch.vertices.reserve (max_batched_quads * 4);
+
+        sorting.enabled    = false;
+        sorting.submitting = false;
+        sorting.layer      = 0;
+        sorting.depth      = 0.f;
+
+        pre_transform.enabled = true;
+        pre_transform.vertices.reserve (max_batched_quads * 4);
+
+        vertex_stream.reset (new Stream_Buffer(stream_buffer_size));
+        quad_indices .reset (new Quad_Index_Buffer(max_batched_quads));
+
+        context->add (vertex_stream);
+        context->add (quad_indices );
+
         shader_program_f.reset (new Shader_Program);
 
         shader_program_f->add (Shader::Source_Code::from_string (internal_vertex_shader_f,   Shader::Source_Code::VERTEX  ));
@@ -118,12 +225,12 @@ namespace basics { namespace opengles
 
         if (shader_program_f->is_usable ())
         {
-            shader_program_f->use ();
-
-             transform_f_id = shader_program_f->get_uniform_id ("transform" );
+                 transform_f_id = shader_program_f->get_uniform_id ("transform" );
             projection_f_id = shader_program_f->get_uniform_id ("projection");
                  color_f_id = shader_program_f->get_uniform_id ("color"     );
                opacity_f_id = shader_program_f->get_uniform_id ("opacity"   );
+
+            vertex_position_location_f = shader_program_f->get_vertex_attribute_id ("vertex_position");
         }
 
         shader_program_t.reset (new Shader_Program);
@@ -141,40 +248,260 @@ namespace basics { namespace opengles
             projection_t_id = shader_program_t->get_uniform_id ("projection");
                sampler_t_id = shader_program_t->get_uniform_id ("sampler"   );
                opacity_t_id = shader_program_t->get_uniform_id ("opacity"   );
+            premultiplied_t_id = shader_program_t->get_uniform_id ("premultiplied");
+                    color_t_id = shader_program_t->get_uniform_id ("color"        );
+               alpha_only_t_id = shader_program_t->get_uniform_id ("alpha_only"   );
 
               vertex_position_location_t = shader_program_t->get_vertex_attribute_id ("vertex_position"  );
             vertex_texture_uv_location_t = shader_program_t->get_vertex_attribute_id ("vertex_texture_uv");
+               vertex_opacity_location_t = shader_program_t->get_vertex_attribute_id ("vertex_opacity"   );
 
             shader_program_t->set_uniform_value (sampler_t_id, 0);
         }
 
+        shader_program_i.reset (new Shader_Program);
+
+        shader_program_i->add (Shader::Source_Code::from_string (internal_vertex_shader_i,   Shader::Source_Code::VERTEX  ));
+        shader_program_i->add (Shader::Source_Code::from_string (internal_fragment_shader_i, Shader::Source_Code::FRAGMENT));
+
+        context->add (shader_program_i);
+
+        if (shader_program_i->is_usable ())
+        {
+            shader_program_i->use ();
+
+             transform_i_id = shader_program_i->get_uniform_id ("transform" );
+            projection_i_id = shader_program_i->get_uniform_id ("projection");
+               sampler_i_id = shader_program_i->get_uniform_id ("sampler"   );
+            premultiplied_i_id = shader_program_i->get_uniform_id ("premultiplied");
+                    color_i_id = shader_program_i->get_uniform_id ("color"        );
+               alpha_only_i_id = shader_program_i->get_uniform_id ("alpha_only"   );
+
+               vertex_corner_location_i = shader_program_i->get_vertex_attribute_id ("vertex_corner"       );
+                instance_rect_location_i = shader_program_i->get_vertex_attribute_id ("instance_rectangle"  );
+                 instance_uvs_location_i = shader_program_i->get_vertex_attribute_id ("instance_texture_uvs");
+             instance_opacity_location_i = shader_program_i->get_vertex_attribute_id ("instance_opacity"    );
+
+            shader_program_i->set_uniform_value (sampler_i_id, 0);
+        }
+
+        detect_instancing ();
+
         reset_state ();
     }
 
     void Canvas_ES2::reset_state ()
     {
-        glEnable      (GL_BLEND);
-        glBlendFunc   (GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-        glClearColor  (0.f, 0.f, 0.f, 1.f);
+        flush ();
+
+        // El estado de OpenGL ES puede haber cambiado sin pasar por este canvas (por ejemplo, al
+        // recrearse el contexto), por lo que se olvida lo que se sabía y se vuelve a subir todo:
+
+        render_state.invalidate   ();
+        render_state.set_blending (true);
+
+        glClearColor (0.f, 0.f, 0.f, 1.f);
+
+        set_size  ({ unsigned(size.width), unsigned(size.height) });
+
+        transform     = Transformation2f();
+        color         = Vector3f{ 1.f, 1.f, 1.f };
+        opacity       = 1.f;
+        blending      = TRANSPARENCY;
+        premultiplied = false;
+        alpha_only    = false;
+
+        invalidate_uniforms (ALL_UNIFORMS);
+    }
+
+    void Canvas_ES2::flush ()
+    {
+        if (!sorting.queue.empty ()) submit_queue ();
+
+        flush_batch ();
+    }
+
+    void Canvas_ES2::flush_batch ()
+    {
+        if (!batch.vertices.empty ())
+        {
+            draw_textured_quads (batch.texture, batch.vertices.data (), batch.vertices.size () / 4);
+
+            batch.vertices.clear ();
+        }
+
+        batch.texture = nullptr;
+    }
+
+    void Canvas_ES2::detect_instancing ()
+    {
+        instancing.enabled                 = true;
+        instancing.available               = false;
+        instancing.draw_elements_instanced = nullptr;
+        instancing.vertex_attrib_divisor   = nullptr;
+
+        // Las funciones de GL_EXT_instanced_arrays y de GL_ANGLE_instanced_arrays tienen la misma
+        // firma, por lo que se puede usar cualquiera de las dos:
+
+        const char * extensions = reinterpret_cast< const char * >(glGetString (GL_EXTENSIONS));
+
+        if (extensions && shader_program_i->is_usable ())
+        {
+            if (std::strstr (extensions, "GL_EXT_instanced_arrays"))
+            {
+                instancing.draw_elements_instanced = reinterpret_cast< PFNGLDRAWELEMENTSINSTANCEDEXTPROC >(eglGetProcAddress ("glDrawElementsInstancedEXT"));
+                instancing.vertex_attrib_divisor   = reinterpret_cast< PFNGLVERTEXATTRIBDIVISOREXTPROC   >(eglGetProcAddress ("glVertexAttribDivisorEXT"  ));
+            }
+            else
+            if (std::strstr (extensions, "GL_ANGLE_instanced_arrays"))
+            {
+                instancing.draw_elements_instanced = reinterpret_cast< PFNGLDRAWELEMENTSINSTANCEDEXTPROC >(eglGetProcAddress ("glDrawElementsInstancedANGLE"));
+                instancing.vertex_attrib_divisor   = reinterpret_cast< PFNGLVERTEXATTRIBDIVISOREXTPROC   >(eglGetProcAddress ("glVertexAttribDivisorANGLE"  ));
+            }
+
+            instancing.available = instancing.draw_elements_instanced && instancing.vertex_attrib_divisor;
+        }
+
+        instancing.data.reserve (sizeof(instance_corners) / sizeof(float) + max_batched_quads * instance_stride);
+    }
+
+    void Canvas_ES2::set_batching (bool enabled)
+    {
+        if (!enabled) flush_batch ();
 
-        set_size      ({ unsigned(size.width), unsigned(size.height) });
-        set_transform (Transformation2f());
-        set_color     (1.f, 1.f, 1.f);
-        set_opacity   (1.f);
+        batch.enabled = enabled;
+    }
+
+    void Canvas_ES2::set_pre_transform (bool enabled)
+    {
+        if (enabled != pre_transform.enabled)
+        {
+            flush_batch ();
+
+            pre_transform.enabled = enabled;
+
+            invalidate_uniforms (TRANSFORM_UNIFORM);
+        }
+    }
+
+    const Canvas_ES2::Vertex * Canvas_ES2::transform_vertices (const Vertex * vertices, size_t number_of_vertices)
+    {
+        if (!pre_transform.enabled) return vertices;
+
+        pre_transform.vertices.resize (number_of_vertices);
+
+        transform_points_2d (transform, &vertices->x, &pre_transform.vertices.front ().x, number_of_vertices, sizeof(Vertex) / sizeof(float));
+
+        // Las coordenadas de textura y la opacidad se copian sin cambios:
+
+        for (size_t index = 0; index < number_of_vertices; ++index)
+        {
+            pre_transform.vertices[index].u       = vertices[index].u;
+            pre_transform.vertices[index].v       = vertices[index].v;
+            pre_transform.vertices[index].opacity = vertices[index].opacity;
+        }
+
+        return pre_transform.vertices.data ();
+    }
+
+    void Canvas_ES2::set_sorting (bool enabled)
+    {
+        // Lo que se haya dibujado antes de cambiar el modo debe quedar por debajo de lo que venga
+        // después:
+
+        flush ();
+
+        sorting.enabled = enabled;
+        sorting.layer   = 0;
+        sorting.depth   = 0.f;
+    }
+
+    void Canvas_ES2::set_layer (int layer, float depth)
+    {
+        sorting.layer = layer;
+        sorting.depth = depth;
+    }
+
+    void Canvas_ES2::submit_queue ()
+    {
+        // Se guarda el estado actual del canvas, ya que cada draw de la cola se envía con el estado
+        // con el que se pidió:
+
+        Draw_State saved_state{ transform, color, opacity, blending };
+
+        sorting.submitting = true;
+
+        sorting.queue.submit
+        (
+            [this] (const Draw_Queue::Command & command, const Draw_State & state, const Vertex * vertices, const Sprite_Instance * instances)
+            {
+                set_transform (state.transform);
+                set_color     (state.color[0], state.color[1], state.color[2]);
+                set_opacity   (state.opacity);
+                set_blending  (state.blending);
+
+                switch (command.key.program)
+                {
+                    case PROGRAM_T: add_textured_quads (static_cast< const Texture_2D * >(command.key.texture), vertices, command.count / 4); break;
+                    case PROGRAM_I: draw_instanced     (instances, command.count);                                                         break;
+                    default:        draw_untextured    (command.mode, vertices, command.count);                                            break;
+                }
+            }
+        );
+
+        flush_batch ();
+
+        set_transform (saved_state.transform);
+        set_color     (saved_state.color[0], saved_state.color[1], saved_state.color[2]);
+        set_opacity   (saved_state.opacity);
+        set_blending  (saved_state.blending);
+
+        sorting.submitting = false;
+    }
+
+    Canvas_ES2::Draw_Queue::Bounds Canvas_ES2::transformed_bounds (float left, float bottom, float right, float top) const
+    {
+        // Se transforman las cuatro esquinas y se toma el rectángulo que las contiene:
+
+        float corners[] = { left, bottom, left, top, right, bottom, right, top };
+
+        transform_points_2d (transform, corners, corners, 4);
+
+        Draw_Queue::Bounds bounds = { corners[0], corners[1], corners[0], corners[1] };
+
+        for (size_t index = 2; index < 8; index += 2)
+        {
+            bounds.merge ({ corners[index], corners[index + 1], corners[index], corners[index + 1] });
+        }
+
+        return bounds;
+    }
+
+    Canvas_ES2::Draw_Queue::Bounds Canvas_ES2::transformed_bounds (const Vertex * vertices, size_t number_of_vertices) const
+    {
+        float left = vertices[0].x, bottom = vertices[0].y, right = left, top = bottom;
+
+        for (size_t index = 1; index < number_of_vertices; ++index)
+        {
+            left   = std::min (left,   vertices[index].x);
+            bottom = std::min (bottom, vertices[index].y);
+            right  = std::max (right,  vertices[index].x);
+            top    = std::max (top,    vertices[index].y);
+        }
+
+        return transformed_bounds (left, bottom, right, top);
     }
 
     void Canvas_ES2::set_size (const Size2u & new_viewport_size)
     {
+        flush_batch ();
+
         size.width  = float(new_viewport_size.width );
         size.height = float(new_viewport_size.height);
         half_size   = size * 0.5f;
         projection  = translate_then_scale_2d (Vector2f{ -half_size.width, -half_size.height }, 2.f / size.width, 2.f / size.height);
 
-        shader_program_f->use ();
-        shader_program_f->set_uniform_value (projection_f_id, projection.matrix);
-
-        shader_program_t->use ();
-        shader_program_t->set_uniform_value (projection_t_id, projection.matrix);
+        invalidate_uniforms (PROJECTION_UNIFORM);
     }
 
     void Canvas_ES2::set_clear_color (float r, float g, float b)
@@ -182,97 +509,220 @@ namespace basics { namespace opengles
         glClearColor (r, g, b, 1.f);
     }
 
-    void Canvas_ES2::set_opacity (float opacity)
+    void Canvas_ES2::set_opacity (float new_opacity)
     {
-        shader_program_f->use ();
-        shader_program_f->set_uniform_value (opacity_f_id, opacity);
-        shader_program_t->use ();
-        shader_program_t->set_uniform_value (opacity_t_id, opacity);
+        // Los setters solo anotan el nuevo valor. Se sube a cada shader program cuando se vaya a
+        // dibujar con él y únicamente si ha cambiado:
+
+        if (new_opacity != opacity)
+        {
+            flush_batch ();
+
+            opacity = new_opacity;
+
+            invalidate_uniforms (OPACITY_UNIFORM);
+        }
+    }
+
+    void Canvas_ES2::set_blending (Blending new_blending)
+    {
+        if (new_blending != blending)
+        {
+            flush_batch ();
+
+            blending = new_blending;
+        }
+    }
+
+    void Canvas_ES2::set_premultiplied (bool new_premultiplied)
+    {
+        if (new_premultiplied != premultiplied)
+        {
+            premultiplied = new_premultiplied;
+
+            dirty_uniforms_t |= PREMULTIPLIED_UNIFORM;
+            dirty_uniforms_i |= PREMULTIPLIED_UNIFORM;
+        }
+    }
+
+    void Canvas_ES2::set_alpha_only (bool new_alpha_only)
+    {
+        if (new_alpha_only != alpha_only)
+        {
+            alpha_only = new_alpha_only;
+
+            dirty_uniforms_t |= ALPHA_ONLY_UNIFORM;
+            dirty_uniforms_i |= ALPHA_ONLY_UNIFORM;
+        }
+    }
+
+    void Canvas_ES2::apply_blending (bool translucent, bool premultiplied_source)
+    {
+        // Con el alfa premultiplicado el color de origen ya está multiplicado por su alfa (y por la
+        // opacidad), por lo que el factor de origen pasa a ser GL_ONE:
+
+        switch (blending)
+        {
+            case NONE:
+            {
+                render_state.set_blending (false);
+                break;
+            }
+
+            case TRANSPARENCY:
+            {
+                render_state.set_blending (translucent, { GLenum(premultiplied_source ? GL_ONE : GL_SRC_ALPHA), GL_ONE_MINUS_SRC_ALPHA });
+                break;
+            }
+
+            case MULTIPLY:
+            {
+                // El destino se multiplica por el color de origen. Con el alfa premultiplicado además
+                // se conserva el destino en los píxeles transparentes:
+
+                render_state.set_blending (true, { GL_DST_COLOR, GLenum(premultiplied_source ? GL_ONE_MINUS_SRC_ALPHA : GL_ZERO) });
+                break;
+            }
+
+            case ADD:
+            {
+                render_state.set_blending (true, { GLenum(premultiplied_source ? GL_ONE : GL_SRC_ALPHA), GL_ONE });
+                break;
+            }
+        }
     }
 
     void Canvas_ES2::set_color (float r, float g, float b)
     {
-        shader_program_f->use ();
-        shader_program_f->set_uniform_value (color_f_id, Vector3f{ r, g, b });
+        // El color solo lo usan las primitivas sin textura, que no se agrupan, y las texturas A8,
+        // por lo que solo hace falta dibujar lo acumulado si el lote es de una textura A8:
+
+        Vector3f new_color{ r, g, b };
+
+        if (!(new_color == color))
+        {
+            if (batch.texture && batch.texture->is_alpha_only ()) flush_batch ();
+
+            color = new_color;
+
+            invalidate_uniforms (COLOR_UNIFORM);
+        }
     }
 
     void Canvas_ES2::set_transform (const Transformation2f & new_transform)
     {
-        transform = new_transform;
+        if (!(new_transform.matrix == transform.matrix))
+        {
+            transform = new_transform;
 
-        shader_program_f->use ();
-        shader_program_f->set_uniform_value (transform_f_id, transform.matrix);
+            if (pre_transform.enabled)
+            {
+                // Los vértices que ya están en el lote se transformaron al añadirlos, por lo que solo
+                // el shader program de las instancias necesita la nueva transformación:
 
-        shader_program_t->use ();
-        shader_program_t->set_uniform_value (transform_t_id, transform.matrix);
+                dirty_uniforms_i |= TRANSFORM_UNIFORM;
+            }
+            else
+            {
+                flush_batch ();
+
+                invalidate_uniforms (TRANSFORM_UNIFORM);
+            }
+        }
     }
 
     void Canvas_ES2::apply_transform (const Transformation2f & t)
     {
-        transform = t * transform;
+        set_transform (t * transform);
+    }
 
+    void Canvas_ES2::use_program_f ()
+    {
         shader_program_f->use ();
-        shader_program_f->set_uniform_value (transform_f_id, transform.matrix);
 
+        if (dirty_uniforms_f)
+        {
+            if (dirty_uniforms_f &  TRANSFORM_UNIFORM) shader_program_f->set_uniform_value ( transform_f_id,  shader_transform ());
+            if (dirty_uniforms_f & PROJECTION_UNIFORM) shader_program_f->set_uniform_value (projection_f_id, projection.matrix);
+            if (dirty_uniforms_f &      COLOR_UNIFORM) shader_program_f->set_uniform_value (     color_f_id, color            );
+            if (dirty_uniforms_f &    OPACITY_UNIFORM) shader_program_f->set_uniform_value (   opacity_f_id, opacity          );
+
+            dirty_uniforms_f = 0;
+        }
+    }
+
+    void Canvas_ES2::use_program_t ()
+    {
         shader_program_t->use ();
-        shader_program_t->set_uniform_value (transform_t_id, transform.matrix);
+
+        if (dirty_uniforms_t)
+        {
+            if (dirty_uniforms_t &  TRANSFORM_UNIFORM) shader_program_t->set_uniform_value ( transform_t_id,  shader_transform ());
+            if (dirty_uniforms_t & PROJECTION_UNIFORM) shader_program_t->set_uniform_value (projection_t_id, projection.matrix);
+            if (dirty_uniforms_t &    OPACITY_UNIFORM) shader_program_t->set_uniform_value (   opacity_t_id, opacity          );
+            if (dirty_uniforms_t & PREMULTIPLIED_UNIFORM) shader_program_t->set_uniform_value (premultiplied_t_id, premultiplied ? 1.f : 0.f);
+            if (dirty_uniforms_t &         COLOR_UNIFORM) shader_program_t->set_uniform_value (        color_t_id, color                    );
+            if (dirty_uniforms_t &    ALPHA_ONLY_UNIFORM) shader_program_t->set_uniform_value (   alpha_only_t_id, alpha_only    ? 1.f : 0.f);
+
+            dirty_uniforms_t = 0;
+        }
+    }
+
+    void Canvas_ES2::use_program_i ()
+    {
+        shader_program_i->use ();
+
+        if (dirty_uniforms_i)
+        {
+            if (dirty_uniforms_i &  TRANSFORM_UNIFORM) shader_program_i->set_uniform_value ( transform_i_id,  transform.matrix);
+            if (dirty_uniforms_i & PROJECTION_UNIFORM) shader_program_i->set_uniform_value (projection_i_id, projection.matrix);
+            if (dirty_uniforms_i & PREMULTIPLIED_UNIFORM) shader_program_i->set_uniform_value (premultiplied_i_id, premultiplied ? 1.f : 0.f);
+            if (dirty_uniforms_i &         COLOR_UNIFORM) shader_program_i->set_uniform_value (        color_i_id, color                    );
+            if (dirty_uniforms_i &    ALPHA_ONLY_UNIFORM) shader_program_i->set_uniform_value (   alpha_only_i_id, alpha_only    ? 1.f : 0.f);
+
+            dirty_uniforms_i = 0;
+        }
     }
 
     void Canvas_ES2::clear ()
     {
+        flush   ();
         glClear (GL_COLOR_BUFFER_BIT);
+
+        // Cada frame empieza borrando la pantalla, por lo que se empieza a escribir en un
+        // almacenamiento de vértices que la GPU no está leyendo:
+
+        vertex_stream->orphan ();
     }
 
     void Canvas_ES2::draw_point (const Point2f & position)
     {
-        shader_program_f->use ();
-
-        glEnableVertexAttribArray  (0);
-        glDisableVertexAttribArray (1);
-        glVertexAttribPointer      (0, 2, GL_FLOAT, GL_FALSE, 0, position.coordinates);
-        glDrawArrays               (GL_POINTS, 0, 1);
+        draw_primitive (GL_POINTS, &position, 1);
     }
 
     void Canvas_ES2::draw_segment (const Point2f & a, const Point2f & b)
     {
-        shader_program_f->use ();
-
         const Point2f coordinates[] = { a, b };
 
-        glEnableVertexAttribArray  (0);
-        glDisableVertexAttribArray (1);
-        glVertexAttribPointer      (0, 2, GL_FLOAT, GL_FALSE, 0, coordinates);
-        glDrawArrays               (GL_LINES, 0, 2);
+        draw_primitive (GL_LINES, coordinates, 2);
     }
 
     void Canvas_ES2::draw_triangle (const Point2f & a, const Point2f & b, const Point2f & c)
     {
-        shader_program_f->use ();
-
         const Point2f coordinates[] = { a, b, c, a };
 
-        glEnableVertexAttribArray  (0);
-        glDisableVertexAttribArray (1);
-        glVertexAttribPointer      (0, 2, GL_FLOAT, GL_FALSE, 0, coordinates);
-        glDrawArrays               (GL_LINE_STRIP, 0, 4);
+        draw_primitive (GL_LINE_STRIP, coordinates, 4);
     }
 
     void Canvas_ES2::fill_triangle (const Point2f & a, const Point2f & b, const Point2f & c)
     {
-        shader_program_f->use ();
-
         const Point2f coordinates[] = { a, b, c };
 
-        glEnableVertexAttribArray  (0);
-        glDisableVertexAttribArray (1);
-        glVertexAttribPointer      (0, 2, GL_FLOAT, GL_FALSE, 0, coordinates);
-        glDrawArrays               (GL_TRIANGLES, 0, 3);
+        draw_primitive (GL_TRIANGLES, coordinates, 3);
     }
 
     void Canvas_ES2::draw_rectangle (const Point2f & bottom_left, const Size2f & size)
     {
-        shader_program_f->use ();
-
         Point2f top_right{ bottom_left.coordinates.x () + size.width, bottom_left.coordinates.y () + size.height };
 
         const Point2f coordinates[] =
@@ -284,16 +734,11 @@ namespace basics { namespace opengles
               bottom_left
         };
 
-        glEnableVertexAttribArray  (0);
-        glDisableVertexAttribArray (1);
-        glVertexAttribPointer      (0, 2, GL_FLOAT, GL_FALSE, 0, coordinates);
-        glDrawArrays               (GL_LINE_STRIP, 0, 5);
+        draw_primitive (GL_LINE_STRIP, coordinates, 5);
     }
 
     void Canvas_ES2::fill_rectangle (const Point2f & bottom_left, const Size2f & size)
     {
-        shader_program_f->use ();
-
         Point2f top_right{ bottom_left.coordinates.x () + size.width, bottom_left.coordinates.y () + size.height };
 
         const Point2f coordinates[] =
@@ -304,10 +749,7 @@ namespace basics { namespace opengles
                 top_right,
         };
 
-        glEnableVertexAttribArray  (0);
-        glDisableVertexAttribArray (1);
-        glVertexAttribPointer      (0, 2, GL_FLOAT, GL_FALSE, 0, coordinates);
-        glDrawArrays               (GL_TRIANGLE_STRIP, 0, 4);
+        draw_primitive (GL_TRIANGLE_STRIP, coordinates, 4);
     }
 
     void Canvas_ES2::fill_rectangle (const Point2f & where, const Size2f & size, const basics::Texture_2D * texture, int handling)
@@ -342,32 +784,16 @@ namespace basics { namespace opengles
                 default:               texture_uvs = normal_texture_uvs; break;
             }
 
-            Point2f top_right
-            {
-                bottom_left.coordinates.x () + size.width,
-                bottom_left.coordinates.y () + size.height
-            };
-
-            const Point2f coordinates[] =
-            {
-                  bottom_left,
-                { bottom_left.coordinates.x (),   top_right.coordinates.y () },
-                {   top_right.coordinates.x (), bottom_left.coordinates.y () },
-                    top_right,
-            };
-
-            opengl_es_texture->use ();
-            shader_program_t ->use ();
-
-            glEnableVertexAttribArray (  vertex_position_location_t);
-            glEnableVertexAttribArray (vertex_texture_uv_location_t);
-            glVertexAttribPointer     (  vertex_position_location_t, 2, GL_FLOAT, GL_FALSE, 0, coordinates);
-            glVertexAttribPointer     (vertex_texture_uv_location_t, 2, GL_FLOAT, GL_FALSE, 0, texture_uvs);
-            glDrawArrays              (GL_TRIANGLE_STRIP, 0, 4);
+            fill_textured_quad (opengl_es_texture, bottom_left, size, texture_uvs);
         }
     }
 
     void Canvas_ES2::fill_rectangle (const Point2f & where, const Size2f & size, const Atlas::Slice * slice, int handling)
+    {
+        fill_slice (where, size, slice, handling, 1.f);
+    }
+
+    void Canvas_ES2::fill_slice (const Point2f & where, const Size2f & size, const Atlas::Slice * slice, int handling, float slice_opacity)
     {
         if (!slice || !slice->atlas)
         {
@@ -420,29 +846,330 @@ namespace basics { namespace opengles
                 std::swap (texture_uvs[2][1], texture_uvs[3][1]);
             }
 
-            Point2f top_right
+            fill_textured_quad (opengl_es_texture, bottom_left, size, texture_uvs, slice_opacity);
+        }
+    }
+
+    void Canvas_ES2::draw_sprites (const Sprite_Instance * instances, size_t count)
+    {
+        if (!is_instancing ())
+        {
+            // Sin instancing cada instancia se expande a un quad que se añade al lote o a la cola. La
+            // opacidad de cada instancia viaja en sus vértices para no tener que cambiar la del
+            // canvas (y cerrar el lote) con cada instancia. Como la opacidad de la instancia
+            // sustituye a la del canvas, esta se deja en 1 mientras tanto:
+
+            float canvas_opacity = opacity;
+
+            set_opacity (1.f);
+
+            for (const Sprite_Instance * instance = instances, * end = instances + count; instance < end; ++instance)
             {
-                bottom_left.coordinates.x () + size.width,
-                bottom_left.coordinates.y () + size.height
-            };
+                fill_slice (instance->position, instance->size, instance->slice, instance->handling, instance->opacity);
+            }
 
-            const Point2f coordinates[] =
+            set_opacity (canvas_opacity);
+        }
+        else
+        if (sorting.enabled && !sorting.submitting)
+        {
+            queue_instances (instances, count);
+        }
+        else
+            draw_instanced  (instances, count);
+    }
+
+    void Canvas_ES2::queue_instances (const Sprite_Instance * instances, size_t count)
+    {
+        // Cada secuencia de instancias que usan la misma textura se guarda como un draw instanciado
+        // que ocupa la unión de los rectángulos de sus instancias:
+
+        const Sprite_Instance * end = instances + count;
+
+        for (const Sprite_Instance * instance = instances; instance < end; )
+        {
+            const Texture_2D * texture = instance->slice && instance->slice->atlas
+                ? dynamic_cast< const opengles::Texture_2D * >(instance->slice->atlas->get_texture ().get ())
+                : nullptr;
+
+            if (!texture)
             {
-                  bottom_left,
-                { bottom_left.coordinates.x (),   top_right.coordinates.y () },
-                {   top_right.coordinates.x (), bottom_left.coordinates.y () },
-                    top_right,
-            };
+                ++instance;
+                continue;
+            }
+
+            const Sprite_Instance * first  = instance;
+            Draw_Queue::Bounds      bounds = { 0.f, 0.f, 0.f, 0.f };
+
+            for ( ; instance < end; ++instance)
+            {
+                if (!instance->slice || !instance->slice->atlas || instance->slice->atlas->get_texture ().get () != texture) break;
+
+                Point2f            bottom_left = instance_bottom_left (*instance);
+                Draw_Queue::Bounds rectangle   = transformed_bounds
+                (
+                    bottom_left[0],
+                    bottom_left[1],
+                    bottom_left[0] + instance->size[0],
+                    bottom_left[1] + instance->size[1]
+                );
+
+                if (instance == first) bounds = rectangle; else bounds.merge (rectangle);
+            }
+
+            sorting.queue.push_instances
+            (
+                { sorting.layer, sorting.depth, PROGRAM_I, texture, BLENDED_DRAW },
+                { transform, color, opacity, blending },
+                bounds,
+                first,
+                size_t(instance - first)
+            );
+        }
+    }
+
+    void Canvas_ES2::draw_instanced (const Sprite_Instance * instances, size_t count)
+    {
+        if (count == 0) return;
+
+        flush_batch ();
+
+        // Se dibuja un único draw call por cada secuencia de instancias que usan la misma textura:
+
+        const Sprite_Instance * end = instances + count;
+
+        for (const Sprite_Instance * instance = instances; instance < end; )
+        {
+            if (!instance->slice || !instance->slice->atlas)
+            {
+                ++instance;
+                continue;
+            }
+
+            const Atlas::Slice * slice   = instance->slice;
+            const Texture_2D   * texture = dynamic_cast< const opengles::Texture_2D * >(slice->atlas->get_texture ().get ());
+
+            if (!texture)
+            {
+                ++instance;
+                continue;
+            }
+
+            float horizontal_ratio = 1.f / texture->get_width  ();
+            float   vertical_ratio = 1.f / texture->get_height ();
+            size_t  number         = 0;
+
+            instancing.data.assign (std::begin (instance_corners), std::end (instance_corners));
+
+            for ( ; instance < end && number < max_batched_quads; ++instance)
+            {
+                slice = instance->slice;
+
+                if (!slice || !slice->atlas || slice->atlas->get_texture ().get () != texture) break;
+
+                const Size2f  & size        = instance->size;
+                      Point2f   bottom_left = instance_bottom_left (*instance);
+
+                // Coordenadas de textura de la esquina inferior izquierda y de la superior derecha:
+
+                float u0 = slice->left   * horizontal_ratio, u1 = slice->right  * horizontal_ratio;
+                float v0 = slice->top    *   vertical_ratio, v1 = slice->bottom *   vertical_ratio;
+
+                if (instance->handling & FLIP_HORIZONTAL) std::swap (u0, u1);
+                if (instance->handling & FLIP_VERTICAL  ) std::swap (v0, v1);
+
+                const float values[instance_stride] = { bottom_left[0], bottom_left[1], size[0], size[1], u0, v0, u1, v1, instance->opacity };
+
+                instancing.data.insert (instancing.data.end (), values, values + instance_stride);
+
+                number++;
+            }
+
+            draw_instances (texture, number);
+        }
+    }
 
-            opengl_es_texture->use ();
-            shader_program_t ->use ();
+    void Canvas_ES2::fill_textured_quad (const Texture_2D * texture, const Point2f & bottom_left, const Size2f & size, const Point2f * texture_uvs, float quad_opacity)
+    {
+        float left   = bottom_left.coordinates.x ();
+        float bottom = bottom_left.coordinates.y ();
+        float right  = left   + size.width;
+        float top    = bottom + size.height;
+
+        const Vertex vertices[] =
+        {
+            { left,  bottom, texture_uvs[0][0], texture_uvs[0][1], quad_opacity },
+            { left,  top,    texture_uvs[1][0], texture_uvs[1][1], quad_opacity },
+            { right, bottom, texture_uvs[2][0], texture_uvs[2][1], quad_opacity },
+            { right, top,    texture_uvs[3][0], texture_uvs[3][1], quad_opacity },
+        };
+
+        add_textured_quads (texture, vertices, 1);
+    }
 
-            glEnableVertexAttribArray (  vertex_position_location_t);
-            glEnableVertexAttribArray (vertex_texture_uv_location_t);
-            glVertexAttribPointer     (  vertex_position_location_t, 2, GL_FLOAT, GL_FALSE, 0, coordinates);
-            glVertexAttribPointer     (vertex_texture_uv_location_t, 2, GL_FLOAT, GL_FALSE, 0, texture_uvs);
-            glDrawArrays              (GL_TRIANGLE_STRIP, 0, 4);
+    void Canvas_ES2::add_textured_quads (const Texture_2D * texture, const Vertex * vertices, size_t number_of_quads)
+    {
+        if (sorting.enabled && !sorting.submitting)
+        {
+            sorting.queue.push
+            (
+                { sorting.layer, sorting.depth, PROGRAM_T, texture, blending_key (texture->is_opaque () && !any_translucent (vertices, number_of_quads * 4)) },
+                { transform, color, opacity, blending },
+                transformed_bounds (vertices, number_of_quads * 4),
+                GL_TRIANGLES,
+                vertices,
+                number_of_quads * 4
+            );
+
+            return;
         }
+
+        vertices = transform_vertices (vertices, number_of_quads * 4);
+
+        if (!batch.enabled)
+        {
+            draw_textured_quads (texture, vertices, number_of_quads);
+
+            return;
+        }
+
+        // Si cambia la textura o se llena el buffer se dibuja lo acumulado hasta el momento:
+
+        for (size_t quad = 0; quad < number_of_quads; ++quad, vertices += 4)
+        {
+            if (texture != batch.texture || batch.vertices.size () >= max_batched_quads * 4)
+            {
+                flush_batch ();
+
+                batch.texture = texture;
+            }
+
+            batch.vertices.insert (batch.vertices.end (), vertices, vertices + 4);
+        }
+    }
+
+    void Canvas_ES2::draw_textured_quads (const Texture_2D * texture, const Vertex * vertices, size_t number_of_quads)
+    {
+        set_premultiplied (texture->is_premultiplied ());
+        set_alpha_only    (texture->is_alpha_only    ());
+
+        texture->use  ();
+        use_program_t ();
+
+        // Las texturas opacas dibujadas sin transparencia no necesitan mezclarse con lo que hay
+        // debajo, lo que ahorra ancho de banda en los fondos que ocupan toda la pantalla:
+
+        apply_blending (!texture->is_opaque () || opacity < 1.f || any_translucent (vertices, number_of_quads * 4), premultiplied);
+
+        const GLvoid * offset = reinterpret_cast< const GLvoid * >(vertex_stream->write (vertices, number_of_quads * 4 * sizeof(Vertex)));
+
+        render_state.enable_vertex_attributes
+        (
+            (1u <<   vertex_position_location_t) |
+            (1u << vertex_texture_uv_location_t) |
+            (1u <<    vertex_opacity_location_t)
+        );
+
+        glVertexAttribPointer     (  vertex_position_location_t, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), offset);
+        glVertexAttribPointer     (vertex_texture_uv_location_t, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), static_cast< const GLfloat * >(offset) + 2);
+        glVertexAttribPointer     (   vertex_opacity_location_t, 1, GL_FLOAT, GL_FALSE, sizeof(Vertex), static_cast< const GLfloat * >(offset) + 4);
+
+        quad_indices->bind ();
+        quad_indices->draw (number_of_quads);
+    }
+
+    void Canvas_ES2::draw_instances (const Texture_2D * texture, size_t number_of_instances)
+    {
+        set_premultiplied (texture->is_premultiplied ());
+        set_alpha_only    (texture->is_alpha_only    ());
+
+        texture->use  ();
+        use_program_i ();
+
+        apply_blending (true, premultiplied);
+
+        // Las esquinas del quad y los datos de las instancias se escriben juntos para que una
+        // posible renovación del buffer no invalide el offset de los primeros:
+
+        const GLubyte * corners   = reinterpret_cast< const GLubyte * >(vertex_stream->write (instancing.data.data (), instancing.data.size () * sizeof(float)));
+        const GLfloat * instances = reinterpret_cast< const GLfloat * >(corners + sizeof(instance_corners));
+        const GLsizei   stride    = GLsizei(instance_stride * sizeof(float));
+
+        render_state.enable_vertex_attributes
+        (
+            (1u <<    vertex_corner_location_i) |
+            (1u <<     instance_rect_location_i) |
+            (1u <<      instance_uvs_location_i) |
+            (1u << instance_opacity_location_i)
+        );
+
+        glVertexAttribPointer (   vertex_corner_location_i, 2, GL_FLOAT, GL_FALSE, 0,      corners      );
+        glVertexAttribPointer (    instance_rect_location_i, 4, GL_FLOAT, GL_FALSE, stride, instances    );
+        glVertexAttribPointer (     instance_uvs_location_i, 4, GL_FLOAT, GL_FALSE, stride, instances + 4);
+        glVertexAttribPointer ( instance_opacity_location_i, 1, GL_FLOAT, GL_FALSE, stride, instances + 8);
+
+        instancing.vertex_attrib_divisor (    instance_rect_location_i, 1);
+        instancing.vertex_attrib_divisor (     instance_uvs_location_i, 1);
+        instancing.vertex_attrib_divisor ( instance_opacity_location_i, 1);
+
+        quad_indices->bind ();
+
+        instancing.draw_elements_instanced (GL_TRIANGLES, 6, GL_UNSIGNED_SHORT, nullptr, GLsizei(number_of_instances));
+
+        // Los divisores son estado de cada location de atributo, por lo que se restauran para no
+        // afectar a los otros shader programs:
+
+        instancing.vertex_attrib_divisor (    instance_rect_location_i, 0);
+        instancing.vertex_attrib_divisor (     instance_uvs_location_i, 0);
+        instancing.vertex_attrib_divisor ( instance_opacity_location_i, 0);
+    }
+
+    void Canvas_ES2::draw_primitive (unsigned mode, const Point2f * points, size_t number_of_points)
+    {
+        // Las primitivas sin textura usan el mismo formato de vértice que los quads para poder
+        // guardarlas en la cola de ordenación (se ignoran las coordenadas de textura):
+
+        Vertex vertices[5];
+
+        for (size_t index = 0; index < number_of_points; ++index)
+        {
+            vertices[index] = { points[index][0], points[index][1], 0.f, 0.f, 1.f };
+        }
+
+        if (sorting.enabled && !sorting.submitting)
+        {
+            sorting.queue.push
+            (
+                { sorting.layer, sorting.depth, PROGRAM_F, nullptr, blending_key (true) },
+                { transform, color, opacity, blending },
+                transformed_bounds (vertices, number_of_points),
+                mode,
+                vertices,
+                number_of_points
+            );
+        }
+        else
+            draw_untextured (mode, vertices, number_of_points);
+    }
+
+    void Canvas_ES2::draw_untextured (unsigned mode, const Vertex * vertices, size_t number_of_vertices)
+    {
+        flush_batch ();
+
+        vertices = transform_vertices (vertices, number_of_vertices);
+
+        use_program_f ();
+
+        // Las primitivas sin textura usan un color sin premultiplicar:
+
+        apply_blending (opacity < 1.f, false);
+
+        const GLvoid * offset = reinterpret_cast< const GLvoid * >(vertex_stream->write (vertices, number_of_vertices * sizeof(Vertex)));
+
+        render_state.enable_vertex_attributes (1u << vertex_position_location_f);
+
+        glVertexAttribPointer     (vertex_position_location_f, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), offset);
+        glDrawArrays              (mode, 0, GLsizei(number_of_vertices));
     }
 
 }}
@@ -0,0 +1,60 @@
+/*
+ * QUAD INDEX BUFFER
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version 1.0
+ * See the LICENSE file or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610171145
+ */
+
+#include <vector>
+#include <basics/assert>
+#include <basics/opengles/Quad_Index_Buffer>
+
+namespace basics { namespace opengles
+{
+
+    bool Quad_Index_Buffer::initialize ()
+    {
+        if (!initialized && number_of_quads > 0)
+        {
+            std::vector< GLushort > indices(number_of_quads * 6);
+
+            GLushort * index = indices.data ();
+
+            for (size_t quad = 0, vertex = 0; quad < number_of_quads; ++quad, vertex += 4)
+            {
+                *index++ = GLushort(vertex + 0);
+                *index++ = GLushort(vertex + 1);
+                *index++ = GLushort(vertex + 2);
+                *index++ = GLushort(vertex + 2);
+                *index++ = GLushort(vertex + 1);
+                *index++ = GLushort(vertex + 3);
+            }
+
+            glGenBuffers (1, &buffer_object_id);
+            glBindBuffer (GL_ELEMENT_ARRAY_BUFFER, buffer_object_id);
+            glBufferData (GL_ELEMENT_ARRAY_BUFFER, GLsizeiptr(indices.size () * sizeof(GLushort)), indices.data (), GL_STATIC_DRAW);
+
+            initialized = glGetError () == GL_NO_ERROR;
+
+            assert(initialized);
+        }
+
+        return initialized;
+    }
+
+    void Quad_Index_Buffer::finalize ()
+    {
+        if (initialized)
+        {
+            glDeleteBuffers (1, &buffer_object_id);
+
+            initialized = false;
+        }
+    }
+
+}}
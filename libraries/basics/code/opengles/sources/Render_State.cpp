@@ -0,0 +1,80 @@
+/*
+ * RENDER STATE
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version 1.0
+ * See the LICENSE file or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610171325
+ */
+
+#include <basics/opengles/Render_State>
+#include <basics/opengles/Shader_Program>
+#include <basics/opengles/Texture_2D>
+
+namespace basics { namespace opengles
+{
+
+    constexpr Render_State::Blend_Function Render_State::unknown_blend_function;
+
+    void Render_State::invalidate ()
+    {
+        // Se desconoce qué atributos están habilitados, por lo que se dan todos por habilitados
+        // para que la siguiente llamada a enable_vertex_attributes() deshabilite los sobrantes:
+
+        GLint max_vertex_attributes = 0;
+
+        glGetIntegerv (GL_MAX_VERTEX_ATTRIBS, &max_vertex_attributes);
+
+        enabled_attributes = max_vertex_attributes >= 32 ? ~uint32_t(0) : (uint32_t(1) << max_vertex_attributes) - 1;
+        blending_known     = false;
+        blending_enabled   = false;
+        blend_function     = unknown_blend_function;
+
+        Shader_Program::disable ();
+        Texture_2D    ::unuse   ();
+    }
+
+    void Render_State::enable_vertex_attributes (uint32_t mask)
+    {
+        uint32_t changed = mask ^ enabled_attributes;
+
+        for (GLuint location = 0; changed != 0; ++location, changed >>= 1)
+        {
+            if (changed & 1)
+            {
+                if (mask & (1u << location))
+                {
+                    glEnableVertexAttribArray  (location);
+                }
+                else
+                {
+                    glDisableVertexAttribArray (location);
+                }
+            }
+        }
+
+        enabled_attributes = mask;
+    }
+
+    void Render_State::set_blending (bool enabled, const Blend_Function & function)
+    {
+        if (!blending_known || enabled != blending_enabled)
+        {
+            if (enabled) glEnable (GL_BLEND); else glDisable (GL_BLEND);
+
+            blending_enabled = enabled;
+            blending_known   = true;
+        }
+
+        if (enabled && !(function == blend_function))
+        {
+            glBlendFunc (function.source, function.destination);
+
+            blend_function = function;
+        }
+    }
+
+}}
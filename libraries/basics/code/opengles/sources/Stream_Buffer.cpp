@@ -0,0 +1,89 @@
+/*
+ * STREAM BUFFER
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version 1.0
+ * See the LICENSE file or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610171140
+ */
+
+#include <basics/assert>
+#include <basics/opengles/Stream_Buffer>
+
+namespace basics { namespace opengles
+{
+
+    bool Stream_Buffer::initialize ()
+    {
+        if (!initialized)
+        {
+            glGenBuffers (1, &buffer_object_id);
+
+            allocate ();
+
+            initialized = glGetError () == GL_NO_ERROR;
+
+            assert(initialized);
+        }
+
+        return initialized;
+    }
+
+    void Stream_Buffer::finalize ()
+    {
+        if (initialized)
+        {
+            glDeleteBuffers (1, &buffer_object_id);
+
+            initialized = false;
+        }
+    }
+
+    size_t Stream_Buffer::write (const void * data, size_t size)
+    {
+        assert(is_usable ());
+
+        // Si los datos no caben en el espacio que queda libre se descarta el almacenamiento
+        // anterior. Si no caben ni siquiera en un buffer vacío, se hace crecer la capacidad:
+
+        if (offset + GLsizeiptr(size) > capacity)
+        {
+            while (GLsizeiptr(size) > capacity) capacity *= 2;
+
+            allocate ();
+        }
+        else
+        {
+            glBindBuffer (GL_ARRAY_BUFFER, buffer_object_id);
+        }
+
+        GLintptr written_at = offset;
+
+        glBufferSubData (GL_ARRAY_BUFFER, written_at, GLsizeiptr(size), data);
+
+        // Se mantiene el siguiente offset alineado a 16 bytes:
+
+        offset = (written_at + GLintptr(size) + 15) & ~GLintptr(15);
+
+        return size_t(written_at);
+    }
+
+    void Stream_Buffer::orphan ()
+    {
+        assert(is_usable ());
+
+        if (offset > 0) allocate ();
+    }
+
+    void Stream_Buffer::allocate ()
+    {
+        glBindBuffer (GL_ARRAY_BUFFER, buffer_object_id);
+        glBufferData (GL_ARRAY_BUFFER, capacity, nullptr, GL_STREAM_DRAW);
+
+        offset = 0;
+    }
+
+}}
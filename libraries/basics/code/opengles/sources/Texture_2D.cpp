@@ -10,7 +10,11 @@
  * C1801221334
  */
 
+#include <algorithm>
+#include <cstring>
 #include <basics/assert>
+#include <basics/pixel_conversion>
+#include <basics/Timer>
 #include <basics/opengles/Texture_2D>
 
 namespace basics { namespace opengles
@@ -20,38 +24,114 @@ namespace basics { namespace opengles
 
     std::shared_ptr< basics::Texture_2D > Texture_2D::create (Id id, Color_Buffer< Rgba8888 > & color_buffer, const Options & options)
     {
-        return std::shared_ptr< Texture_2D >(new Texture_2D(color_buffer, options.width, options.height));
+        return std::shared_ptr< Texture_2D >(new Texture_2D(std::move (color_buffer), options));
+    }
+
+    std::shared_ptr< basics::Texture_2D > Texture_2D::create_compressed (Id /*id*/, Compressed_Image & compressed_image, const Options & options)
+    {
+        return std::shared_ptr< Texture_2D >(new Texture_2D(std::move (compressed_image), options));
+    }
+
+    bool Texture_2D::supports (Compressed_Image::Format format)
+    {
+        switch (format)
+        {
+            case Compressed_Image::ETC1_RGB8: return has_extension ("GL_OES_compressed_ETC1_RGB8_texture");
+        }
+
+        return false;
+    }
+
+    bool Texture_2D::has_extension (const char * name)
+    {
+        const char * extensions = reinterpret_cast< const char * >(glGetString (GL_EXTENSIONS));
+
+        return extensions && std::strstr (extensions, name);
+    }
+
+    size_t Texture_2D::get_memory_size () const
+    {
+        if (!compressed_image.data.empty ()) return compressed_image.data.size ();
+
+        size_t pixel_size = format == RGBA8888 ? 4 : format == A8 ? 1 : 2;
+        size_t size       = size_t(width) * size_t(height) * pixel_size;
+
+        // La cadena de mipmaps ocupa un tercio más que el primer nivel:
+
+        return mipmaps ? size + size / 3 : size;
     }
 
     bool Texture_2D::initialize ()
     {
         if (!initialized)
         {
-            if (color_buffer.size () > 0)
+            // Si el contexto no admite el formato de una textura comprimida, se descomprime en la CPU
+            // y se sube como cualquier otra:
+
+            if (!compressed_image.data.empty () && !supports (compressed_image.format))
+            {
+                decompress (compressed_image, color_buffer);
+
+                compressed_image.data.clear ();
+            }
+
+            if (color_buffer.size () > 0 || !compressed_image.data.empty ())
             {
                 glEnable        (GL_TEXTURE_2D);////
                 glGenTextures   (1, &texture_object_id);
                 glBindTexture   (GL_TEXTURE_2D, texture_object_id);
 
-                glTexParameteri (GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-                glTexParameteri (GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+                // La textura recién creada queda enlazada, por lo que se anota como activa:
+
+                active_texture = this;
+
+                // OpenGL ES 2 solo admite mipmaps en texturas cuyas dimensiones no son potencia de 2 con
+                // GL_OES_texture_npot. Tampoco se generan para las texturas comprimidas:
+
+                unsigned texture_width  = unsigned(width );
+                unsigned texture_height = unsigned(height);
+                bool     power_of_two   = (texture_width & (texture_width - 1)) == 0 && (texture_height & (texture_height - 1)) == 0;
+                bool     use_mipmaps    = mipmaps && compressed_image.data.empty () && (power_of_two || has_extension ("GL_OES_texture_npot"));
+
+                GLint    mag_filter     = filter == NEAREST ? GL_NEAREST : GL_LINEAR;
+                GLint    min_filter     = use_mipmaps ? (filter == NEAREST ? GL_NEAREST_MIPMAP_NEAREST : GL_LINEAR_MIPMAP_LINEAR) : mag_filter;
+
+                glTexParameteri (GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, min_filter);
+                glTexParameteri (GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, mag_filter);
                 glTexParameteri (GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
                 glTexParameteri (GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
 
-                glTexImage2D
-                (
-                    GL_TEXTURE_2D,
-                    0,
-                    GL_RGBA,
-                    color_buffer.get_width  (),
-                    color_buffer.get_height (),
-                    0,
-                    GL_RGBA,
-                    GL_UNSIGNED_BYTE,
-                    color_buffer
-                );
-
-                int error = glGetError ();
+                if (!compressed_image.data.empty ())
+                {
+                    glCompressedTexImage2D
+                    (
+                        GL_TEXTURE_2D,
+                        0,
+                        GL_ETC1_RGB8_OES,
+                        compressed_image.width,
+                        compressed_image.height,
+                        0,
+                        GLsizei(compressed_image.data.size ()),
+                        compressed_image.data.data ()
+                    );
+                }
+                else
+                if (staging.enabled)
+                {
+                    // Solo se reserva la memoria. La imagen se sube por franjas desde continue_upload():
+
+                    allocate ();
+
+                    staging.next_row     = 0;
+                    staging.mipmaps      = use_mipmaps;
+                    staging.power_of_two = power_of_two;
+                }
+                else
+                {
+                    upload (0, color_buffer);
+
+                    if (use_mipmaps) generate_mipmaps (power_of_two);
+                }
 
                 assert(glGetError () == GL_NO_ERROR);
                 assert(width > 0 && height > 0);
@@ -63,14 +143,141 @@ namespace basics { namespace opengles
         return initialized;
     }
 
+    bool Texture_2D::continue_upload (float budget_seconds)
+    {
+        if (!initialized || is_ready ()) return true;
+
+        Timer timer;
+
+        glActiveTexture (GL_TEXTURE0);
+        glBindTexture   (GL_TEXTURE_2D, texture_object_id);
+
+        active_texture = this;
+
+        // El número de filas de cada franja es múltiplo de 4 para que el tramado de RGB565 y RGBA4444
+        // coincida con el de una subida completa:
+
+        unsigned texture_width  = unsigned(width );
+        unsigned texture_height = unsigned(height);
+        unsigned strip_rows     = std::max (4u, (strip_size / (texture_width * 4)) & ~3u);
+
+        // Las filas de color_buffer ocupan todo el ancho de la textura, por lo que cada franja se sube
+        // directamente desde su primera fila:
+
+        do
+        {
+            unsigned         rows  = std::min (strip_rows, texture_height - staging.next_row);
+            const Rgba8888 * first = color_buffer.buffer.data () + size_t(staging.next_row) * texture_width;
+
+            upload (0, first, texture_width, rows, GLint(staging.next_row));
+
+            staging.next_row += rows;
+        }
+        while (staging.next_row < texture_height && timer.get_elapsed_seconds () < budget_seconds);
+
+        if (staging.next_row < texture_height) return false;
+
+        if (staging.mipmaps) generate_mipmaps (staging.power_of_two);
+
+        return true;
+    }
+
+    void Texture_2D::generate_mipmaps (bool power_of_two)
+    {
+        // La GPU genera los mipmaps de las texturas potencia de 2. Los del resto se generan en la CPU
+        // reduciendo cada nivel a la mitad:
+
+        if (power_of_two)
+        {
+            glGenerateMipmap (GL_TEXTURE_2D);
+        }
+        else
+        {
+            Color_Buffer< Rgba8888 > level = color_buffer;
+            Color_Buffer< Rgba8888 > next;
+
+            for (GLint index = 1; level.get_width () > 1 || level.get_height () > 1; ++index)
+            {
+                downsample_2x2 (level, next);
+                upload         (index, next);
+
+                std::swap (level, next);
+            }
+        }
+    }
+
+    void Texture_2D::transfer_format (GLenum & gl_format, GLenum & gl_type) const
+    {
+        switch (format)
+        {
+            case RGB565:   gl_format = GL_RGB;   gl_type = GL_UNSIGNED_SHORT_5_6_5;   break;
+            case RGBA4444: gl_format = GL_RGBA;  gl_type = GL_UNSIGNED_SHORT_4_4_4_4; break;
+            case A8:       gl_format = GL_ALPHA; gl_type = GL_UNSIGNED_BYTE;          break;
+            default:       gl_format = GL_RGBA;  gl_type = GL_UNSIGNED_BYTE;          break;
+        }
+    }
+
+    void Texture_2D::allocate ()
+    {
+        GLenum gl_format, gl_type;
+
+        transfer_format (gl_format, gl_type);
+
+        glTexImage2D (GL_TEXTURE_2D, 0, gl_format, GLsizei(width), GLsizei(height), 0, gl_format, gl_type, nullptr);
+    }
+
+    void Texture_2D::upload (GLint level, const Color_Buffer< Rgba8888 > & pixels)
+    {
+        upload (level, pixels.buffer.data (), pixels.get_width (), pixels.get_height ());
+    }
+
+    void Texture_2D::upload (GLint level, const Rgba8888 * pixels, unsigned width, unsigned height, GLint first_row)
+    {
+        const GLvoid * data = pixels;
+
+        std::vector< uint16_t > converted_16;
+        std::vector< uint8_t  > converted_8;
+
+        switch (format)
+        {
+            case RGB565:   convert_to_rgb565   (pixels, width, height, converted_16, dither); data = converted_16.data (); break;
+            case RGBA4444: convert_to_rgba4444 (pixels, width, height, converted_16, dither); data = converted_16.data (); break;
+            case A8:       convert_to_a8       (pixels, width, height, converted_8);          data = converted_8 .data (); break;
+            default:       break;
+        }
+
+        GLenum gl_format, gl_type;
+
+        transfer_format (gl_format, gl_type);
+
+        // Las filas de los formatos de 8 y 16 bits no siempre ocupan un múltiplo de 4 bytes:
+
+        if (format != RGBA8888) glPixelStorei (GL_UNPACK_ALIGNMENT, 1);
+
+        // Con first_row se sustituye una franja de filas de una textura ya reservada:
+
+        if (first_row < 0)
+        {
+            glTexImage2D    (GL_TEXTURE_2D, level, gl_format, GLsizei(width), GLsizei(height), 0, gl_format, gl_type, data);
+        }
+        else
+        {
+            glTexSubImage2D (GL_TEXTURE_2D, level, 0, first_row, GLsizei(width), GLsizei(height), gl_format, gl_type, data);
+        }
+
+        if (format != RGBA8888) glPixelStorei (GL_UNPACK_ALIGNMENT, 4);
+    }
+
     bool Texture_2D::use () const
     {
         assert(is_usable ());
 
-        //if (active_texture != this)
+        // Solo se enlaza la textura si no es la que ya está enlazada:
+
+        if (active_texture != this)
         {
-            glBindTexture   (GL_TEXTURE_2D, texture_object_id);
             glActiveTexture (GL_TEXTURE0);
+            glBindTexture   (GL_TEXTURE_2D, texture_object_id);
 
             active_texture  = this;
 
@@ -0,0 +1,58 @@
+/*
+ *  ETC1
+ *  Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ *  Distributed under the Boost Software License, version  1.0
+ *  See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ *  angel.rodriguez@esne.edu
+ *
+ *  C2610172200
+ */
+
+#ifndef BASICS_ETC1_HEADER
+#define BASICS_ETC1_HEADER
+
+    #include <cstddef>
+    #include <vector>
+    #include <basics/Color_Buffer>
+
+    namespace basics
+    {
+
+        /**
+         * Compresión ETC1 (GL_OES_compressed_ETC1_RGB8_texture): cada bloque de 4x4 píxeles ocupa 8
+         * bytes, por lo que una textura RGB ocupa la octava parte que en RGBA8888. No guarda alfa,
+         * así que solo se debe usar con imágenes opacas.
+         * El codificador está pensado para usarse fuera de línea. El decodificador permite cargar las
+         * texturas en contextos que no admiten el formato.
+         */
+
+        /** Bytes que ocupa una imagen del tamaño indicado (se redondea a bloques completos). */
+        inline size_t etc1_data_size (unsigned width, unsigned height)
+        {
+            return size_t((width + 3) / 4) * size_t((height + 3) / 4) * 8;
+        }
+
+        /**
+         * Comprime una imagen. Los bloques se guardan por filas en el mismo orden que las filas de
+         * color_buffer. Los bloques incompletos de los bordes se rellenan repitiendo el último píxel.
+         */
+        void etc1_encode (const Color_Buffer< Rgba8888 > & color_buffer, std::vector< byte > & encoded_data);
+
+        /**
+         * Descomprime una imagen en un buffer RGBA8888 con alfa 255.
+         * @return false si no hay suficientes datos para las dimensiones indicadas.
+         */
+        bool etc1_decode
+        (
+            const byte               * encoded_data,
+            size_t                     encoded_size,
+            unsigned                   width,
+            unsigned                   height,
+            Color_Buffer< Rgba8888 > & color_buffer
+        );
+
+    }
+
+#endif
@@ -20,6 +20,12 @@
 
         bool png_decode (const std::vector< byte > & encoded_data, Color_Buffer< Rgba8888 > & color_buffer, unsigned & width, unsigned & height);
 
+        /**
+         * Igual que la anterior, pero además indica en opaque si todos los píxeles de la imagen
+         * decodificada tienen alfa 255.
+         */
+        bool png_decode (const std::vector< byte > & encoded_data, Color_Buffer< Rgba8888 > & color_buffer, unsigned & width, unsigned & height, bool & opaque);
+
     }
 
 #endif
@@ -0,0 +1,101 @@
+/*
+ *  RAW TEXTURE
+ *  Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ *  Distributed under the Boost Software License, version  1.0
+ *  See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ *  angel.rodriguez@esne.edu
+ *
+ *  C2610172100
+ */
+
+#ifndef BASICS_RAW_TEXTURE_HEADER
+#define BASICS_RAW_TEXTURE_HEADER
+
+    #include <cstdint>
+    #include <vector>
+    #include <basics/Color_Buffer>
+
+    namespace basics
+    {
+
+        /**
+         * Contenedor de texturas listas para subir a la GPU: una cabecera de tamaño fijo seguida de
+         * los píxeles tal cual se suben a la GPU (sin comprimir o en bloques ETC1), de modo que cargarlas no requiere más que
+         * copiar los datos. Los archivos se generan en tiempo de compilación a partir de los PNG con
+         * la herramienta tools/raw_texture_converter y se guardan junto a ellos con la extensión
+         * raw_texture_extension. Todos los campos se guardan en little endian.
+         */
+        struct Raw_Texture_Header
+        {
+            enum Format : uint16_t
+            {
+                RGBA8888  = 0,
+                ETC1_RGB8 = 1,                      ///< Bloques ETC1 (ver etc1).
+            };
+
+            enum Flags : uint16_t
+            {
+                PREMULTIPLIED = 1 << 0,             ///< El color de cada píxel ya está multiplicado por su alfa.
+                OPAQUE        = 1 << 1,             ///< Todos los píxeles tienen alfa 255.
+            };
+
+            char     magic[4];                      ///< "BTEX"
+            uint16_t version;
+            uint16_t format;
+            uint32_t width;
+            uint32_t height;
+            uint16_t flags;
+            uint16_t reserved;
+            uint32_t data_size;                     ///< Bytes de píxeles que siguen a la cabecera.
+        };
+
+        static_assert(sizeof(Raw_Texture_Header) == 24, "Raw_Texture_Header must not have padding.");
+
+        extern const char raw_texture_extension[];  ///< ".btex"
+
+        /**
+         * Comprueba la cabecera de un archivo de textura en bruto.
+         * @return Un puntero a la cabecera dentro de encoded_data o nullptr si no es válida o si los
+         *     datos están truncados.
+         */
+        const Raw_Texture_Header * raw_texture_header (const std::vector< byte > & encoded_data);
+
+        /** Guarda píxeles ya convertidos al formato indicado (data_size = pixel_data.size ()). */
+        void raw_texture_encode
+        (
+            Raw_Texture_Header::Format       format,
+            unsigned                         width,
+            unsigned                         height,
+            bool                             opaque,
+            bool                             premultiplied,
+            const std::vector< byte >      & pixel_data,
+            std::vector< byte >            & encoded_data
+        );
+
+        void raw_texture_encode
+        (
+            const Color_Buffer< Rgba8888 > & color_buffer,
+            bool                             opaque,
+            bool                             premultiplied,
+            std::vector< byte >            & encoded_data
+        );
+
+        /**
+         * Obtiene los píxeles en RGBA8888. Los formatos comprimidos se descomprimen, por lo que solo
+         * conviene usarla cuando no se pueden subir tal cual a la GPU.
+         */
+        bool raw_texture_decode
+        (
+            const std::vector< byte >      & encoded_data,
+            Color_Buffer< Rgba8888 >       & color_buffer,
+            unsigned                       & width,
+            unsigned                       & height,
+            bool                           & opaque,
+            bool                           & premultiplied
+        );
+
+    }
+
+#endif
@@ -0,0 +1,359 @@
+/*
+ * ETC1
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610172210
+ */
+
+#include <algorithm>
+#include <climits>
+#include <basics/etc1>
+
+namespace basics
+{
+
+    namespace
+    {
+
+        // Modificadores de luminancia de cada tabla (los otros dos valores son los negativos):
+
+        const int modifier_tables[8][2] =
+        {
+            {  2,   8 }, {  5,  17 }, {  9,  29 }, { 13,  42 },
+            { 18,  60 }, { 24,  80 }, { 33, 106 }, { 47, 183 },
+        };
+
+        // Orden de los modificadores según el índice de 2 bits de cada píxel:
+
+        inline int modifier (int table, int index)
+        {
+            int value = modifier_tables[table][index & 1];
+
+            return index & 2 ? -value : value;
+        }
+
+        inline int clamp_255 (int value)
+        {
+            return value < 0 ? 0 : value > 255 ? 255 : value;
+        }
+
+        inline int expand_4 (int value) { return (value << 4) | value;        }
+        inline int expand_5 (int value) { return (value << 3) | (value >> 2); }
+
+        // Los dos subbloques de 8 píxeles están uno al lado del otro (flip = 0) o uno encima del
+        // otro (flip = 1):
+
+        inline int subblock_of (int x, int y, bool flip)
+        {
+            return flip ? y >> 1 : x >> 1;
+        }
+
+        struct Subblock_Fit
+        {
+            int      table;
+            int      indices[16];           ///< Índice de cada píxel del bloque (solo los del subbloque).
+            unsigned error;
+        };
+
+        // Busca para un color base la tabla y los índices que menos error producen en un subbloque:
+
+        void fit_subblock (const int (& pixels)[16][3], bool flip, int subblock, const int (& base)[3], Subblock_Fit & fit)
+        {
+            fit.error = UINT_MAX;
+
+            for (int table = 0; table < 8; ++table)
+            {
+                int      indices[16];
+                unsigned error = 0;
+
+                for (int pixel = 0; pixel < 16 && error < fit.error; ++pixel)
+                {
+                    if (subblock_of (pixel & 3, pixel >> 2, flip) != subblock) continue;
+
+                    unsigned best_error = UINT_MAX;
+
+                    for (int index = 0; index < 4; ++index)
+                    {
+                        int      delta = modifier (table, index);
+                        int      r     = clamp_255 (base[0] + delta) - pixels[pixel][0];
+                        int      g     = clamp_255 (base[1] + delta) - pixels[pixel][1];
+                        int      b     = clamp_255 (base[2] + delta) - pixels[pixel][2];
+                        unsigned e     = unsigned(r * r + g * g + b * b);
+
+                        if (e < best_error)
+                        {
+                            best_error     = e;
+                            indices[pixel] = index;
+                        }
+                    }
+
+                    error += best_error;
+                }
+
+                if (error < fit.error)
+                {
+                    fit.table = table;
+                    fit.error = error;
+
+                    std::copy (indices, indices + 16, fit.indices);
+                }
+            }
+        }
+
+        void average (const int (& pixels)[16][3], bool flip, int subblock, int (& result)[3])
+        {
+            int sum[3] = { 0, 0, 0 };
+
+            for (int pixel = 0; pixel < 16; ++pixel)
+            {
+                if (subblock_of (pixel & 3, pixel >> 2, flip) == subblock)
+                {
+                    sum[0] += pixels[pixel][0];
+                    sum[1] += pixels[pixel][1];
+                    sum[2] += pixels[pixel][2];
+                }
+            }
+
+            for (int channel = 0; channel < 3; ++channel) result[channel] = (sum[channel] + 4) / 8;
+        }
+
+        struct Block_Fit
+        {
+            bool         flip;
+            bool         differential;
+            int          colors[2][3];      ///< Colores base cuantizados (4 o 5 bits).
+            Subblock_Fit subblocks[2];
+            unsigned     error;
+        };
+
+        void write_block (const Block_Fit & fit, byte * block)
+        {
+            for (int channel = 0; channel < 3; ++channel)
+            {
+                if (fit.differential)
+                {
+                    int delta = fit.colors[1][channel] - fit.colors[0][channel];
+
+                    block[channel] = byte((fit.colors[0][channel] << 3) | (delta & 7));
+                }
+                else
+                {
+                    block[channel] = byte((fit.colors[0][channel] << 4) | fit.colors[1][channel]);
+                }
+            }
+
+            block[3] = byte((fit.subblocks[0].table << 5) | (fit.subblocks[1].table << 2) | (fit.differential << 1) | fit.flip);
+
+            // Los bits de los índices se guardan por columnas: primero los 16 bits altos y luego los
+            // 16 bits bajos:
+
+            unsigned msb = 0, lsb = 0;
+
+            for (int pixel = 0; pixel < 16; ++pixel)
+            {
+                int x     = pixel & 3;
+                int y     = pixel >> 2;
+                int index = fit.subblocks[subblock_of (x, y, fit.flip)].indices[pixel];
+                int bit   = x * 4 + y;
+
+                msb |= unsigned(index >> 1) << bit;
+                lsb |= unsigned(index &  1) << bit;
+            }
+
+            block[4] = byte(msb >> 8);
+            block[5] = byte(msb     );
+            block[6] = byte(lsb >> 8);
+            block[7] = byte(lsb     );
+        }
+
+        void encode_block (const int (& pixels)[16][3], byte * block)
+        {
+            // El modo individual siempre es válido, pero best se inicializa por si ningún candidato
+            // mejorase el error inicial:
+
+            Block_Fit best      = {};
+            Block_Fit candidate = {};
+
+            best.error = UINT_MAX;
+
+            for (int flip = 0; flip < 2; ++flip)
+            {
+                int averages[2][3];
+
+                average (pixels, flip != 0, 0, averages[0]);
+                average (pixels, flip != 0, 1, averages[1]);
+
+                candidate.flip = flip != 0;
+
+                for (int differential = 0; differential < 2; ++differential)
+                {
+                    candidate.differential = differential != 0;
+
+                    // Se cuantizan los colores medios a 4 bits (modo individual) o a 5 bits (modo
+                    // diferencial, que solo es posible si la diferencia cabe en 3 bits con signo):
+
+                    bool valid = true;
+
+                    for (int channel = 0; channel < 3; ++channel)
+                    {
+                        for (int subblock = 0; subblock < 2; ++subblock)
+                        {
+                            int value = averages[subblock][channel];
+
+                            candidate.colors[subblock][channel] = differential ? (value * 31 + 127) / 255 : (value * 15 + 127) / 255;
+                        }
+
+                        int delta = candidate.colors[1][channel] - candidate.colors[0][channel];
+
+                        if (differential && (delta < -4 || delta > 3)) valid = false;
+                    }
+
+                    if (!valid) continue;
+
+                    candidate.error = 0;
+
+                    for (int subblock = 0; subblock < 2; ++subblock)
+                    {
+                        int base[3];
+
+                        for (int channel = 0; channel < 3; ++channel)
+                        {
+                            int value = candidate.colors[subblock][channel];
+
+                            base[channel] = differential ? expand_5 (value) : expand_4 (value);
+                        }
+
+                        fit_subblock (pixels, candidate.flip, subblock, base, candidate.subblocks[subblock]);
+
+                        candidate.error += candidate.subblocks[subblock].error;
+                    }
+
+                    if (candidate.error < best.error) best = candidate;
+                }
+            }
+
+            write_block (best, block);
+        }
+
+        void decode_block (const byte * block, byte * target, unsigned pitch, unsigned columns, unsigned rows)
+        {
+            bool differential = (block[3] & 2) != 0;
+            bool flip         = (block[3] & 1) != 0;
+            int  tables[2]    = { block[3] >> 5, (block[3] >> 2) & 7 };
+            int  bases [2][3];
+
+            for (int channel = 0; channel < 3; ++channel)
+            {
+                if (differential)
+                {
+                    int color = block[channel] >> 3;
+                    int delta = int(block[channel] & 7) - (block[channel] & 4 ? 8 : 0);
+
+                    bases[0][channel] = expand_5 (color);
+                    bases[1][channel] = expand_5 ((color + delta) & 31);
+                }
+                else
+                {
+                    bases[0][channel] = expand_4 (block[channel] >> 4);
+                    bases[1][channel] = expand_4 (block[channel] & 15);
+                }
+            }
+
+            unsigned msb = unsigned(block[4]) << 8 | block[5];
+            unsigned lsb = unsigned(block[6]) << 8 | block[7];
+
+            for (unsigned y = 0; y < rows; ++y)
+            {
+                byte * pixel = target + y * pitch;
+
+                for (unsigned x = 0; x < columns; ++x, pixel += 4)
+                {
+                    int bit      = int(x * 4 + y);
+                    int index    = int(((msb >> bit) & 1) << 1 | ((lsb >> bit) & 1));
+                    int subblock = subblock_of (int(x), int(y), flip);
+                    int delta    = modifier (tables[subblock], index);
+
+                    pixel[0] = byte(clamp_255 (bases[subblock][0] + delta));
+                    pixel[1] = byte(clamp_255 (bases[subblock][1] + delta));
+                    pixel[2] = byte(clamp_255 (bases[subblock][2] + delta));
+                    pixel[3] = 255;
+                }
+            }
+        }
+
+    }
+
+    void etc1_encode (const Color_Buffer< Rgba8888 > & color_buffer, std::vector< byte > & encoded_data)
+    {
+        unsigned width  = color_buffer.get_width  ();
+        unsigned height = color_buffer.get_height ();
+
+        encoded_data.resize (etc1_data_size (width, height));
+
+        if (width == 0 || height == 0) return;
+
+        const byte * source = reinterpret_cast< const byte * >(color_buffer.buffer.data ());
+        byte       * block  = encoded_data.data ();
+
+        for (unsigned block_y = 0; block_y < height; block_y += 4)
+        {
+            for (unsigned block_x = 0; block_x < width; block_x += 4, block += 8)
+            {
+                int pixels[16][3];
+
+                for (unsigned pixel = 0; pixel < 16; ++pixel)
+                {
+                    unsigned     x     = std::min (block_x + (pixel & 3 ), width  - 1);
+                    unsigned     y     = std::min (block_y + (pixel >> 2), height - 1);
+                    const byte * color = source + (size_t(y) * width + x) * 4;
+
+                    pixels[pixel][0] = color[0];
+                    pixels[pixel][1] = color[1];
+                    pixels[pixel][2] = color[2];
+                }
+
+                encode_block (pixels, block);
+            }
+        }
+    }
+
+    bool etc1_decode
+    (
+        const byte               * encoded_data,
+        size_t                     encoded_size,
+        unsigned                   width,
+        unsigned                   height,
+        Color_Buffer< Rgba8888 > & color_buffer
+    )
+    {
+        if (encoded_size < etc1_data_size (width, height)) return false;
+
+        color_buffer.resize (width, height);
+
+        byte     * target = color_buffer;
+        unsigned   pitch  = width * 4;
+
+        for (unsigned block_y = 0; block_y < height; block_y += 4)
+        {
+            for (unsigned block_x = 0; block_x < width; block_x += 4, encoded_data += 8)
+            {
+                decode_block
+                (
+                    encoded_data,
+                    target + size_t(block_y) * pitch + block_x * 4,
+                    pitch,
+                    std::min (4u, width  - block_x),
+                    std::min (4u, height - block_y)
+                );
+            }
+        }
+
+        return true;
+    }
+
+}
@@ -34,6 +34,18 @@ Rename this file to lodepng.cpp to use it for C++, or to lodepng.c to use it for
 #include <stdio.h>
 #include <stdlib.h>
 
+/*SIMD instruction sets used by the scanline unfilter kernels, if available. Define
+LODEPNG_NO_SIMD to always use the scalar unfilter (used by tools/png_decode_benchmark)*/
+#if defined(LODEPNG_NO_SIMD)
+/*scalar unfilter only*/
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define LODEPNG_UNFILTER_NEON
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define LODEPNG_UNFILTER_SSE2
+#endif
+
 #if defined(_MSC_VER) && (_MSC_VER >= 1310) /*Visual Studio: A few warning types are not desired here.*/
 #pragma warning( disable : 4244 ) /*implicit conversions: not warned by gcc -Wall -Wextra and requires too much casts*/
 #pragma warning( disable : 4996 ) /*VS does not like fopen, but fopen_s is not standard C so unusable here*/
@@ -513,6 +525,7 @@ typedef struct HuffmanTree
   unsigned* lengths; /*the lengths of the codes of the 1d-tree*/
   unsigned maxbitlen; /*maximum number of bits a single code can get*/
   unsigned numcodes; /*number of symbols in the alphabet = number of codes*/
+  unsigned* table; /*decoder lookup table indexed by the next FIRSTBITS bits of the stream, see HuffmanTree_makeTable*/
 } HuffmanTree;
 
 /*function used for debug purposes to draw the tree in ascii art with C++*/
@@ -533,6 +546,7 @@ static void HuffmanTree_init(HuffmanTree* tree)
   tree->tree2d = 0;
   tree->tree1d = 0;
   tree->lengths = 0;
+  tree->table = 0;
 }
 
 static void HuffmanTree_cleanup(HuffmanTree* tree)
@@ -540,6 +554,7 @@ static void HuffmanTree_cleanup(HuffmanTree* tree)
   lodepng_free(tree->tree2d);
   lodepng_free(tree->tree1d);
   lodepng_free(tree->lengths);
+  lodepng_free(tree->table);
 }
 
 /*the tree representation used by the decoder. return value is error*/
@@ -940,6 +955,75 @@ static unsigned generateFixedDistanceTree(HuffmanTree* tree)
 
 #ifdef LODEPNG_COMPILE_DECODER
 
+/*
+Lookup table for the decoder. It's indexed by the next FIRSTBITS bits of the stream (in stream order,
+the first bit being the least significant one) and each entry holds:
+bits 0-8: first symbol, bits 9-17: second symbol, bits 18-21: length of the first code,
+bits 22-26: length of both codes, bit 27: set if the entry holds two literals.
+A length of 0 means the code is longer than FIRSTBITS and the tree must be walked instead.
+Two literals are stored in the same entry when both codes fit in FIRSTBITS bits, so runs of short
+literal codes are decoded two at a time.
+*/
+#define FIRSTBITS 9u
+#define TABLE_SIZE (1u << FIRSTBITS)
+#define TABLE_SYMBOL(entry) ((entry) & 511u)
+#define TABLE_SECOND(entry) (((entry) >> 9) & 511u)
+#define TABLE_LENGTH(entry) (((entry) >> 18) & 15u)
+#define TABLE_TOTAL(entry) (((entry) >> 22) & 31u)
+#define TABLE_PAIR(entry) (((entry) >> 27) & 1u)
+
+static unsigned reverseBits(unsigned bits, unsigned num)
+{
+  unsigned i, result = 0;
+  for(i = 0; i < num; i++) result |= ((bits >> (num - i - 1u)) & 1u) << i;
+  return result;
+}
+
+static unsigned HuffmanTree_makeTable(HuffmanTree* tree, unsigned pairs)
+{
+  unsigned n, index;
+
+  tree->table = (unsigned*)lodepng_malloc(TABLE_SIZE * sizeof(unsigned));
+  if(!tree->table) return 83; /*alloc fail*/
+
+  for(index = 0; index != TABLE_SIZE; ++index) tree->table[index] = 0;
+
+  for(n = 0; n != tree->numcodes; ++n)
+  {
+    unsigned length = tree->lengths[n];
+    if(length == 0 || length > FIRSTBITS) continue;
+    /*the code appears in the stream with its first bit in the least significant position*/
+    for(index = reverseBits(tree->tree1d[n], length); index < TABLE_SIZE; index += 1u << length)
+    {
+      tree->table[index] = n | (length << 18) | (length << 22);
+    }
+  }
+
+  if(pairs)
+  {
+    for(index = 0; index != TABLE_SIZE; ++index)
+    {
+      unsigned first = tree->table[index], second, length;
+      if(TABLE_LENGTH(first) == 0 || TABLE_SYMBOL(first) > 255) continue;
+      length = TABLE_LENGTH(first);
+      /*the remaining FIRSTBITS - length bits of the index are the start of the next code*/
+      second = tree->table[index >> length];
+      if(TABLE_LENGTH(second) == 0 || TABLE_SYMBOL(second) > 255 || TABLE_LENGTH(second) > FIRSTBITS - length) continue;
+      tree->table[index] = TABLE_SYMBOL(first) | (TABLE_SYMBOL(second) << 9) | (length << 18)
+                         | ((length + TABLE_LENGTH(second)) << 22) | (1u << 27);
+    }
+  }
+
+  return 0;
+}
+
+/*returns the next bits of the stream, at least 17 of them. The caller must check that 3 bytes are available*/
+static unsigned peekBits(const unsigned char* in, size_t bp)
+{
+  const unsigned char* p = &in[bp >> 3];
+  return ((unsigned)p[0] | ((unsigned)p[1] << 8) | ((unsigned)p[2] << 16)) >> (bp & 7u);
+}
+
 /*
 returns the code, or (unsigned)(-1) if error happened
 inbitlength is the length of the complete buffer, in bits (so its byte length times 8)
@@ -963,6 +1047,22 @@ static unsigned huffmanDecodeSymbol(const unsigned char* in, size_t* bp,
     if(treepos >= codetree->numcodes) return (unsigned)(-1); /*error: it appeared outside the codetree*/
   }
 }
+
+/*same as huffmanDecodeSymbol, but uses the lookup table of the tree when possible*/
+static unsigned huffmanDecodeSymbolFast(const unsigned char* in, size_t* bp,
+                                        const HuffmanTree* codetree, size_t inlength)
+{
+  if(((*bp) >> 3) + 3 <= inlength)
+  {
+    unsigned entry = codetree->table[peekBits(in, *bp) & (TABLE_SIZE - 1)];
+    if(TABLE_LENGTH(entry))
+    {
+      *bp += TABLE_LENGTH(entry);
+      return TABLE_SYMBOL(entry);
+    }
+  }
+  return huffmanDecodeSymbol(in, bp, codetree, inlength * 8);
+}
 #endif /*LODEPNG_COMPILE_DECODER*/
 
 #ifdef LODEPNG_COMPILE_DECODER
@@ -1142,14 +1242,39 @@ static unsigned inflateHuffmanBlock(ucvector* out, const unsigned char* in, size
   if(btype == 1) getTreeInflateFixed(&tree_ll, &tree_d);
   else if(btype == 2) error = getTreeInflateDynamic(&tree_ll, &tree_d, in, bp, inlength);
 
+  if(!error) error = HuffmanTree_makeTable(&tree_ll, 1);
+  if(!error) error = HuffmanTree_makeTable(&tree_d, 0);
+
   while(!error) /*decode all symbols until end reached, breaks at end code*/
   {
     /*code_ll is literal, length or end code*/
-    unsigned code_ll = huffmanDecodeSymbol(in, bp, &tree_ll, inbitlength);
+    unsigned code_ll;
+    if(((*bp) >> 3) + 3 <= inlength)
+    {
+      /*fast path: the next code (or the next two literal codes) are looked up in the table*/
+      unsigned entry = tree_ll.table[peekBits(in, *bp) & (TABLE_SIZE - 1)];
+      if(TABLE_PAIR(entry))
+      {
+        if((*pos) + 2 <= out->allocsize) out->size = (*pos) + 2;
+        else if(!ucvector_resize(out, (*pos) + 2)) ERROR_BREAK(83 /*alloc fail*/);
+        out->data[(*pos)++] = (unsigned char)TABLE_SYMBOL(entry);
+        out->data[(*pos)++] = (unsigned char)TABLE_SECOND(entry);
+        *bp += TABLE_TOTAL(entry);
+        continue;
+      }
+      else if(TABLE_LENGTH(entry))
+      {
+        code_ll = TABLE_SYMBOL(entry);
+        *bp += TABLE_LENGTH(entry);
+      }
+      else code_ll = huffmanDecodeSymbol(in, bp, &tree_ll, inbitlength);
+    }
+    else code_ll = huffmanDecodeSymbol(in, bp, &tree_ll, inbitlength);
     if(code_ll <= 255) /*literal symbol*/
     {
       /*ucvector_push_back would do the same, but for some reason the two lines below run 10% faster*/
-      if(!ucvector_resize(out, (*pos) + 1)) ERROR_BREAK(83 /*alloc fail*/);
+      if((*pos) + 1 <= out->allocsize) out->size = (*pos) + 1;
+      else if(!ucvector_resize(out, (*pos) + 1)) ERROR_BREAK(83 /*alloc fail*/);
       out->data[*pos] = (unsigned char)code_ll;
       ++(*pos);
     }
@@ -1168,7 +1293,7 @@ static unsigned inflateHuffmanBlock(ucvector* out, const unsigned char* in, size
       length += readBitsFromStream(bp, in, numextrabits_l);
 
       /*part 3: get distance code*/
-      code_d = huffmanDecodeSymbol(in, bp, &tree_d, inbitlength);
+      code_d = huffmanDecodeSymbolFast(in, bp, &tree_d, inlength);
       if(code_d > 29)
       {
         if(code_d == (unsigned)(-1)) /*huffmanDecodeSymbol returns (unsigned)(-1) in case of error*/
@@ -1194,10 +1319,16 @@ static unsigned inflateHuffmanBlock(ucvector* out, const unsigned char* in, size
 
       if(!ucvector_resize(out, (*pos) + length)) ERROR_BREAK(83 /*alloc fail*/);
       if (distance < length) {
-        for(forward = 0; forward < length; ++forward)
+        /*the copy repeats the last distance bytes: after copying a multiple of distance bytes, the
+        bytes already copied can be used as source of a copy that doesn't overlap*/
+        unsigned char* target = out->data + *pos;
+        memcpy(target, out->data + backward, distance);
+        for(forward = distance; forward < length; forward += backward)
         {
-          out->data[(*pos)++] = out->data[backward++];
+          backward = forward < length - forward ? forward : length - forward;
+          memcpy(target + forward, target, backward);
         }
+        *pos += length;
       } else {
         memcpy(out->data + *pos, out->data + backward, length);
         *pos += length;
@@ -3968,6 +4099,165 @@ unsigned lodepng_inspect(unsigned* w, unsigned* h, LodePNGState* state,
   return state->error;
 }
 
+#if defined(LODEPNG_UNFILTER_SSE2) || defined(LODEPNG_UNFILTER_NEON)
+
+/*reads or writes one pixel of 3 or 4 bytes*/
+static unsigned loadPixel(const unsigned char* p, size_t bytewidth)
+{
+  unsigned value = 0;
+  memcpy(&value, p, bytewidth);
+  return value;
+}
+
+static void storePixel(unsigned char* p, unsigned value, size_t bytewidth)
+{
+  memcpy(p, &value, bytewidth);
+}
+
+/*
+Vectorized versions of the filters of unfilterScanline. Up works on 16 bytes at a time. Sub, Average
+and Paeth depend on the previous pixel, so they work on one whole pixel at a time, for 3 or 4 bytes
+per pixel (8-bit RGB and RGBA). The results are identical to the ones of the scalar code.
+Returns 1 if the scanline was unfiltered, 0 if the scalar code must be used instead.
+*/
+static unsigned unfilterScanlineSIMD(unsigned char* recon, const unsigned char* scanline, const unsigned char* precon,
+                                     size_t bytewidth, unsigned char filterType, size_t length)
+{
+  size_t i;
+
+  if(filterType == 2 && precon)
+  {
+    for(i = 0; i + 16 <= length; i += 16)
+    {
+#if defined(LODEPNG_UNFILTER_SSE2)
+      __m128i x = _mm_loadu_si128((const __m128i*)&scanline[i]);
+      __m128i b = _mm_loadu_si128((const __m128i*)&precon[i]);
+      _mm_storeu_si128((__m128i*)&recon[i], _mm_add_epi8(x, b));
+#else
+      vst1q_u8(&recon[i], vaddq_u8(vld1q_u8(&scanline[i]), vld1q_u8(&precon[i])));
+#endif
+    }
+    for(; i != length; ++i) recon[i] = scanline[i] + precon[i];
+    return 1;
+  }
+
+  if(bytewidth != 3 && bytewidth != 4) return 0;
+  if(filterType != 1 && !precon) return 0;
+
+#if defined(LODEPNG_UNFILTER_SSE2)
+  {
+    const __m128i zero = _mm_setzero_si128();
+    __m128i a = zero; /*previous pixel of recon*/
+    __m128i c = zero; /*previous pixel of precon, widened to 16 bits*/
+
+#define LOAD_PIXEL(p) _mm_cvtsi32_si128((int)loadPixel(p, bytewidth))
+#define STORE_PIXEL(p, v) storePixel(p, (unsigned)_mm_cvtsi128_si32(v), bytewidth)
+
+    switch(filterType)
+    {
+      case 1:
+        for(i = 0; i != length; i += bytewidth)
+        {
+          a = _mm_add_epi8(a, LOAD_PIXEL(&scanline[i]));
+          STORE_PIXEL(&recon[i], a);
+        }
+        return 1;
+      case 3:
+        for(i = 0; i != length; i += bytewidth)
+        {
+          __m128i b = LOAD_PIXEL(&precon[i]);
+          /*_mm_avg_epu8 rounds up, the PNG average rounds down*/
+          __m128i average = _mm_sub_epi8(_mm_avg_epu8(a, b), _mm_and_si128(_mm_xor_si128(a, b), _mm_set1_epi8(1)));
+          a = _mm_add_epi8(LOAD_PIXEL(&scanline[i]), average);
+          STORE_PIXEL(&recon[i], a);
+        }
+        return 1;
+      case 4:
+        for(i = 0; i != length; i += bytewidth)
+        {
+          __m128i b = _mm_unpacklo_epi8(LOAD_PIXEL(&precon[i]), zero);
+          __m128i a16 = _mm_unpacklo_epi8(a, zero);
+          __m128i pa = _mm_sub_epi16(b, c);
+          __m128i pb = _mm_sub_epi16(a16, c);
+          __m128i pc = _mm_add_epi16(pa, pb);
+          __m128i predictor, use_b, use_c;
+          pa = _mm_max_epi16(pa, _mm_sub_epi16(zero, pa));
+          pb = _mm_max_epi16(pb, _mm_sub_epi16(zero, pb));
+          pc = _mm_max_epi16(pc, _mm_sub_epi16(zero, pc));
+          /*same choice as paethPredictor: c if pc < pa and pc < pb, else b if pb < pa, else a*/
+          use_b = _mm_cmplt_epi16(pb, pa);
+          use_c = _mm_and_si128(_mm_cmplt_epi16(pc, pa), _mm_cmplt_epi16(pc, pb));
+          predictor = _mm_or_si128(_mm_and_si128(use_b, b), _mm_andnot_si128(use_b, a16));
+          predictor = _mm_or_si128(_mm_and_si128(use_c, c), _mm_andnot_si128(use_c, predictor));
+          a = _mm_add_epi8(LOAD_PIXEL(&scanline[i]), _mm_packus_epi16(predictor, predictor));
+          STORE_PIXEL(&recon[i], a);
+          c = b;
+        }
+        return 1;
+    }
+
+#undef LOAD_PIXEL
+#undef STORE_PIXEL
+  }
+#else
+  {
+    uint8x8_t a = vdup_n_u8(0); /*previous pixel of recon*/
+    int16x8_t c = vdupq_n_s16(0); /*previous pixel of precon, widened to 16 bits*/
+
+#define LOAD_PIXEL(p) vreinterpret_u8_u32(vdup_n_u32(loadPixel(p, bytewidth)))
+#define STORE_PIXEL(p, v) storePixel(p, vget_lane_u32(vreinterpret_u32_u8(v), 0), bytewidth)
+
+    switch(filterType)
+    {
+      case 1:
+        for(i = 0; i != length; i += bytewidth)
+        {
+          a = vadd_u8(a, LOAD_PIXEL(&scanline[i]));
+          STORE_PIXEL(&recon[i], a);
+        }
+        return 1;
+      case 3:
+        for(i = 0; i != length; i += bytewidth)
+        {
+          /*vhadd_u8 computes (a + b) >> 1 without overflow, as the PNG average*/
+          a = vadd_u8(LOAD_PIXEL(&scanline[i]), vhadd_u8(a, LOAD_PIXEL(&precon[i])));
+          STORE_PIXEL(&recon[i], a);
+        }
+        return 1;
+      case 4:
+        for(i = 0; i != length; i += bytewidth)
+        {
+          int16x8_t b = vreinterpretq_s16_u16(vmovl_u8(LOAD_PIXEL(&precon[i])));
+          int16x8_t a16 = vreinterpretq_s16_u16(vmovl_u8(a));
+          int16x8_t pa = vsubq_s16(b, c);
+          int16x8_t pb = vsubq_s16(a16, c);
+          int16x8_t pc = vabsq_s16(vaddq_s16(pa, pb));
+          int16x8_t predictor;
+          uint16x8_t use_b, use_c;
+          pa = vabsq_s16(pa);
+          pb = vabsq_s16(pb);
+          /*same choice as paethPredictor: c if pc < pa and pc < pb, else b if pb < pa, else a*/
+          use_b = vcltq_s16(pb, pa);
+          use_c = vandq_u16(vcltq_s16(pc, pa), vcltq_s16(pc, pb));
+          predictor = vbslq_s16(use_b, b, a16);
+          predictor = vbslq_s16(use_c, c, predictor);
+          a = vadd_u8(LOAD_PIXEL(&scanline[i]), vmovn_u16(vreinterpretq_u16_s16(predictor)));
+          STORE_PIXEL(&recon[i], a);
+          c = b;
+        }
+        return 1;
+    }
+
+#undef LOAD_PIXEL
+#undef STORE_PIXEL
+  }
+#endif
+
+  return 0;
+}
+
+#endif /*LODEPNG_UNFILTER_SSE2 || LODEPNG_UNFILTER_NEON*/
+
 static unsigned unfilterScanline(unsigned char* recon, const unsigned char* scanline, const unsigned char* precon,
                                  size_t bytewidth, unsigned char filterType, size_t length)
 {
@@ -3981,6 +4271,9 @@ static unsigned unfilterScanline(unsigned char* recon, const unsigned char* scan
   */
 
   size_t i;
+#if defined(LODEPNG_UNFILTER_SSE2) || defined(LODEPNG_UNFILTER_NEON)
+  if(unfilterScanlineSIMD(recon, scanline, precon, bytewidth, filterType, length)) return 0;
+#endif
   switch(filterType)
   {
     case 0:
@@ -4521,9 +4814,12 @@ static unsigned readChunk_pHYs(LodePNGInfo* info, const unsigned char* data, siz
 #endif /*LODEPNG_COMPILE_ANCILLARY_CHUNKS*/
 
 /*read a PNG, the result will be in the same color type as the PNG (hence "generic")*/
+/*dest: optional caller-provided buffer of destsize bytes. It is used as output when the PNG color mode
+doesn't need to be converted and it's large enough, so that the image isn't allocated twice.*/
 static void decodeGeneric(unsigned char** out, unsigned* w, unsigned* h,
                           LodePNGState* state,
-                          const unsigned char* in, size_t insize)
+                          const unsigned char* in, size_t insize,
+                          unsigned char* dest, size_t destsize)
 {
   unsigned char IEND = 0;
   const unsigned char* chunk;
@@ -4722,15 +5018,22 @@ static void decodeGeneric(unsigned char** out, unsigned* w, unsigned* h,
   if(!state->error)
   {
     outsize = lodepng_get_raw_size(*w, *h, &state->info_png.color);
-    *out = (unsigned char*)lodepng_malloc(outsize);
+    if(dest && destsize >= outsize
+       && (!state->decoder.color_convert || lodepng_color_mode_equal(&state->info_raw, &state->info_png.color)))
+    {
+      *out = dest;
+    }
+    else *out = (unsigned char*)lodepng_malloc(outsize);
     if(!*out) state->error = 83; /*alloc fail*/
   }
   if(!state->error)
   {
-    for(i = 0; i < outsize; i++) (*out)[i] = 0;
+    /*only the images with less than 8 bits per pixel need a zeroed output, the others are fully written*/
+    if(lodepng_get_bpp(&state->info_png.color) < 8) memset(*out, 0, outsize);
     state->error = postProcessScanlines(*out, scanlines.data, *w, *h, &state->info_png);
   }
   ucvector_cleanup(&scanlines);
+  if(state->error && *out == dest) *out = 0;
 }
 
 unsigned lodepng_decode(unsigned char** out, unsigned* w, unsigned* h,
@@ -4738,7 +5041,7 @@ unsigned lodepng_decode(unsigned char** out, unsigned* w, unsigned* h,
                         const unsigned char* in, size_t insize)
 {
   *out = 0;
-  decodeGeneric(out, w, h, state, in, insize);
+  decodeGeneric(out, w, h, state, in, insize, 0, 0);
   if(state->error) return state->error;
   if(!state->decoder.color_convert || lodepng_color_mode_equal(&state->info_raw, &state->info_png.color))
   {
@@ -4778,6 +5081,33 @@ unsigned lodepng_decode(unsigned char** out, unsigned* w, unsigned* h,
   return state->error;
 }
 
+unsigned lodepng_decode_into(unsigned char* out, size_t outsize, unsigned* w, unsigned* h,
+                             LodePNGState* state,
+                             const unsigned char* in, size_t insize)
+{
+  unsigned char* data = 0;
+  decodeGeneric(&data, w, h, state, in, insize, out, outsize);
+  if(state->error)
+  {
+    if(data != out) lodepng_free(data);
+    return state->error;
+  }
+  if(data == out)
+  {
+    /*decoded in place, the color mode of out is the one of the PNG*/
+    if(!state->decoder.color_convert) state->error = lodepng_color_mode_copy(&state->info_raw, &state->info_png.color);
+    return state->error;
+  }
+  /*the PNG has a different color mode: it's converted from the temporary buffer into out*/
+  if(!state->decoder.color_convert) state->error = 56;
+  else if(!(state->info_raw.colortype == LCT_RGB || state->info_raw.colortype == LCT_RGBA)
+          && !(state->info_raw.bitdepth == 8)) state->error = 56; /*unsupported color mode conversion*/
+  else if(lodepng_get_raw_size(*w, *h, &state->info_raw) > outsize) state->error = 84; /*out is too small*/
+  else state->error = lodepng_convert(out, data, &state->info_raw, &state->info_png.color, *w, *h);
+  lodepng_free(data);
+  return state->error;
+}
+
 unsigned lodepng_decode_memory(unsigned char** out, unsigned* w, unsigned* h, const unsigned char* in,
                                size_t insize, LodePNGColorType colortype, unsigned bitdepth)
 {
@@ -655,6 +655,16 @@ unsigned lodepng_decode(unsigned char** out, unsigned* w, unsigned* h,
                         LodePNGState* state,
                         const unsigned char* in, size_t insize);
 
+/*
+Same as lodepng_decode, but writes the image into a buffer provided by the caller instead of
+allocating it. outsize is the size of out in bytes, which must be at least the raw size of the
+image in the color mode state->info_raw (use lodepng_inspect to know its dimensions first).
+When the PNG doesn't need color conversion the scanlines are unfiltered directly into out.
+*/
+unsigned lodepng_decode_into(unsigned char* out, size_t outsize, unsigned* w, unsigned* h,
+                             LodePNGState* state,
+                             const unsigned char* in, size_t insize);
+
 /*
 Read the PNG header, but not the actual data. This returns only the information
 that is in the header chunk of the PNG, such as width, height and color type. The
@@ -24,32 +24,68 @@ namespace basics
         unsigned & height
     )
     {
-        std::vector< byte > decoded_data;
+        bool opaque;
 
-        int error = lodepng::decode
+        return png_decode (encoded_data, color_buffer, width, height, opaque);
+    }
+
+    bool png_decode
+    (
+        const std::vector< byte > & encoded_data,
+        Color_Buffer < Rgba8888 > & color_buffer,
+        unsigned & width,
+        unsigned & height,
+        bool     & opaque
+    )
+    {
+        if (encoded_data.empty ()) return false;
+
+        // Se lee la cabecera para conocer las dimensiones de la imagen y poder reservar el buffer
+        // de destino, en el que se decodifican directamente los píxeles:
+
+        lodepng::State state;
+
+        state.info_raw.colortype = LCT_RGBA;
+        state.info_raw.bitdepth  = 8;
+
+        if (lodepng_inspect (&width, &height, &state, encoded_data.data (), encoded_data.size ()) != 0)
+        {
+            return false;
+        }
+
+        color_buffer.resize (width, height);
+
+        int error = lodepng_decode_into
         (
-            decoded_data,
-            width,
-            height,
-            encoded_data,
-            LCT_RGBA,
-            8
+            color_buffer,
+            size_t(color_buffer.size ()) * sizeof(Rgba8888),
+            &width,
+            &height,
+            &state,
+            encoded_data.data (),
+            encoded_data.size ()
         );
 
         if (!error)
         {
-            color_buffer.resize (width, height);
+            // Se combinan los valores de alfa de todos los píxeles (el cuarto byte de cada uno):
 
-            byte * buffer = color_buffer;
+            const byte * pixels = color_buffer;
+            const byte * end    = pixels + size_t(color_buffer.size ()) * sizeof(Rgba8888);
+                  byte   alpha  = 255;
 
-            for (auto i = decoded_data.begin (); i != decoded_data.end (); ++i)
+            for (pixels += 3; pixels < end; pixels += 4)
             {
-                *buffer++ = *i;
+                alpha &= *pixels;
             }
 
+            opaque = alpha == 255;
+
             return true;
         }
 
+        color_buffer.resize (0, 0);
+
         return false;
     }
 
@@ -0,0 +1,141 @@
+/*
+ * RAW TEXTURE
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610172110
+ */
+
+#include <cstring>
+#include <basics/etc1>
+#include <basics/raw_texture>
+
+namespace basics
+{
+
+    namespace
+    {
+
+        const char     magic[4] = { 'B', 'T', 'E', 'X' };
+        const uint16_t version  = 1;
+
+    }
+
+    const char raw_texture_extension[] = ".btex";
+
+    const Raw_Texture_Header * raw_texture_header (const std::vector< byte > & encoded_data)
+    {
+        if (encoded_data.size () < sizeof(Raw_Texture_Header)) return nullptr;
+
+        auto header = reinterpret_cast< const Raw_Texture_Header * >(encoded_data.data ());
+
+        if (std::memcmp (header->magic, magic, sizeof(magic)) != 0 || header->version != version)
+        {
+            return nullptr;
+        }
+
+        if (encoded_data.size () - sizeof(Raw_Texture_Header) < header->data_size)
+        {
+            return nullptr;
+        }
+
+        return header;
+    }
+
+    void raw_texture_encode
+    (
+        Raw_Texture_Header::Format       format,
+        unsigned                         width,
+        unsigned                         height,
+        bool                             opaque,
+        bool                             premultiplied,
+        const std::vector< byte >      & pixel_data,
+        std::vector< byte >            & encoded_data
+    )
+    {
+        Raw_Texture_Header header{};
+
+        std::memcpy (header.magic, magic, sizeof(magic));
+
+        header.version   = version;
+        header.format    = format;
+        header.width     = width;
+        header.height    = height;
+        header.flags     = uint16_t((opaque ? Raw_Texture_Header::OPAQUE : 0) | (premultiplied ? Raw_Texture_Header::PREMULTIPLIED : 0));
+        header.data_size = uint32_t(pixel_data.size ());
+
+        encoded_data.resize (sizeof(header) + header.data_size);
+
+        std::memcpy (encoded_data.data (), &header, sizeof(header));
+        std::memcpy (encoded_data.data () + sizeof(header), pixel_data.data (), header.data_size);
+    }
+
+    void raw_texture_encode
+    (
+        const Color_Buffer< Rgba8888 > & color_buffer,
+        bool                             opaque,
+        bool                             premultiplied,
+        std::vector< byte >            & encoded_data
+    )
+    {
+        const byte * pixels = reinterpret_cast< const byte * >(color_buffer.buffer.data ());
+
+        raw_texture_encode
+        (
+            Raw_Texture_Header::RGBA8888,
+            color_buffer.get_width  (),
+            color_buffer.get_height (),
+            opaque,
+            premultiplied,
+            std::vector< byte >(pixels, pixels + size_t(color_buffer.size ()) * sizeof(Rgba8888)),
+            encoded_data
+        );
+    }
+
+    bool raw_texture_decode
+    (
+        const std::vector< byte >      & encoded_data,
+        Color_Buffer< Rgba8888 >       & color_buffer,
+        unsigned                       & width,
+        unsigned                       & height,
+        bool                           & opaque,
+        bool                           & premultiplied
+    )
+    {
+        const Raw_Texture_Header * header = raw_texture_header (encoded_data);
+
+        if (!header) return false;
+
+        const byte * pixels = encoded_data.data () + sizeof(Raw_Texture_Header);
+
+        if (header->format == Raw_Texture_Header::ETC1_RGB8)
+        {
+            if (!etc1_decode (pixels, header->data_size, header->width, header->height, color_buffer)) return false;
+        }
+        else
+        if (header->format == Raw_Texture_Header::RGBA8888 && uint64_t(header->width) * header->height * sizeof(Rgba8888) == header->data_size)
+        {
+            // Los píxeles ya están en el formato de la textura, así que basta con copiarlos:
+
+            color_buffer.resize (header->width, header->height);
+
+            std::memcpy (color_buffer, pixels, header->data_size);
+        }
+        else
+        {
+            return false;
+        }
+
+        width         = header->width;
+        height        = header->height;
+        opaque        = (header->flags & Raw_Texture_Header::OPAQUE       ) != 0;
+        premultiplied = (header->flags & Raw_Texture_Header::PREMULTIPLIED) != 0;
+
+        return true;
+    }
+
+}
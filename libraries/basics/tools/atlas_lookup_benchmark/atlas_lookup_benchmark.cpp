@@ -0,0 +1,199 @@
+/*
+ * ATLAS LOOKUP BENCHMARK
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610181420
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <memory>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+#include <basics/Atlas>
+#include <basics/fnv>
+
+using namespace basics;
+using namespace std;
+
+namespace
+{
+
+    typedef chrono::steady_clock Clock;
+
+    // Ids como los de los slices de los .sprites (hash de su nombre) o como los de Raster_Font
+    // (códigos de carácter consecutivos):
+
+    vector< Id > make_ids (size_t count, bool consecutive)
+    {
+        vector< Id > ids;
+        set   < Id > used;
+
+        for (size_t index = 0; ids.size () < count; ++index)
+        {
+            Id id;
+
+            if (consecutive)
+            {
+                id = Id(32 + index);
+            }
+            else
+            {
+                string name = "slice_" + to_string (index);
+
+                id = Id(fnv32 (reinterpret_cast< const byte * >(name.data ()), name.size ()));
+            }
+
+            if (used.insert (id).second) ids.push_back (id);
+        }
+
+        return ids;
+    }
+
+    // Comprueba que se encuentran todos los slices, que no se encuentran los que no existen y que
+    // los punteros a los slices no cambian al añadir otros:
+
+    bool check_atlas (Atlas & atlas, const vector< Id > & ids)
+    {
+        vector< const Atlas::Slice * > pointers;
+
+        for (size_t index = 0; index < ids.size (); ++index)
+        {
+            pointers.push_back (atlas.add_slice (ids[index], { float(index), 0.f }, { 1.f, 1.f }));
+
+            if (!pointers.back () || atlas.add_slice (ids[index], { 0.f, 0.f }, { 1.f, 1.f }) != nullptr)
+            {
+                fprintf (stderr, "%u slices: slice %u could not be added or was added twice\n", unsigned(ids.size ()), unsigned(index));
+                return false;
+            }
+        }
+
+        for (size_t index = 0; index < ids.size (); ++index)
+        {
+            const Atlas::Slice * slice = atlas.get_slice (ids[index]);
+
+            if (slice != pointers[index] || slice->left != float(index))
+            {
+                fprintf (stderr, "%u slices: slice %u moved or was not found\n", unsigned(ids.size ()), unsigned(index));
+                return false;
+            }
+        }
+
+        set< Id > used(ids.begin (), ids.end ());
+
+        for (Id id = 0; id < 1000; ++id)
+        {
+            if (used.count (id * 7919u + 1u) == 0 && atlas.get_slice (id * 7919u + 1u) != nullptr)
+            {
+                fprintf (stderr, "%u slices: a missing id was found\n", unsigned(ids.size ()));
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    // Ejecuta function tres veces y retorna el menor tiempo por búsqueda en nanosegundos:
+
+    template< typename FUNCTION >
+    double nanoseconds_per_lookup (size_t lookups, FUNCTION function)
+    {
+        double fastest = 0.0;
+
+        for (unsigned run = 0; run < 3; ++run)
+        {
+            Clock::time_point start = Clock::now ();
+
+            function ();
+
+            double time = chrono::duration< double, nano >(Clock::now () - start).count () / double(lookups);
+
+            if (run == 0 || time < fastest) fastest = time;
+        }
+
+        return fastest;
+    }
+
+    bool benchmark (size_t slice_count, bool consecutive, size_t lookups)
+    {
+        vector< Id > ids = make_ids (slice_count, consecutive);
+        Atlas        atlas(shared_ptr< Texture_2D >{});
+
+        if (!check_atlas (atlas, ids)) return false;
+
+        map< Id, Atlas::Slice > slice_map;
+
+        for (Id id : ids) slice_map[id] = *atlas.get_slice (id);
+
+        // Se buscan slices existentes en orden aleatorio:
+
+        mt19937                            random(static_cast< unsigned >(slice_count));
+        uniform_int_distribution< size_t > random_index(0, ids.size () - 1);
+        vector< Id >                       sequence(lookups);
+
+        for (Id & id : sequence) id = ids[random_index (random)];
+
+        volatile float sink = 0.f;
+
+        double atlas_time = nanoseconds_per_lookup
+        (
+            lookups, [&] ()
+            {
+                float sum = 0.f;
+
+                for (Id id : sequence) sum += atlas.get_slice (id)->left;
+
+                sink = sum;
+            }
+        );
+
+        double map_time = nanoseconds_per_lookup
+        (
+            lookups, [&] ()
+            {
+                float sum = 0.f;
+
+                for (Id id : sequence) sum += slice_map.find (id)->second.left;
+
+                sink = sum;
+            }
+        );
+
+        printf
+        (
+            "%6u slices (%-11s)  Atlas::get_slice %6.1f ns  std::map %6.1f ns\n",
+            unsigned(slice_count), consecutive ? "consecutive" : "hashed", atlas_time, map_time
+        );
+
+        return true;
+    }
+
+}
+
+int main (int number_of_arguments, char * arguments[])
+{
+    size_t lookups = number_of_arguments > 1 ? size_t(max (1, atoi (arguments[1]))) : 1000000;
+    bool   success = true;
+
+    const size_t slice_counts[] = { 10, 100, 1000, 10000 };
+
+    for (bool consecutive : { false, true })
+    {
+        for (size_t slice_count : slice_counts)
+        {
+            success &= benchmark (slice_count, consecutive, lookups);
+        }
+    }
+
+    return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
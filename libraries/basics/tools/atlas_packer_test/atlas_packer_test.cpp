@@ -0,0 +1,357 @@
+/*
+ * ATLAS PACKER TEST
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610181400
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <vector>
+#include <basics/Atlas_Packer>
+#include <basics/enable>
+#include <basics/Headless_Context>
+#include <basics/Headless_Window>
+#include <basics/Memory_Texture_2D>
+#include <basics/pixel_conversion>
+
+using namespace basics;
+using namespace std;
+
+namespace
+{
+
+    // Marca las zonas ocupadas de una página para detectar solapamientos:
+
+    class Coverage
+    {
+
+        unsigned       width;
+        unsigned       height;
+        vector< bool > used;
+
+    public:
+
+        Coverage(unsigned width = 0, unsigned height = 0)
+        :
+            width (width ),
+            height(height),
+            used  (size_t(width) * height, false)
+        {
+        }
+
+        /** @return false si el rectángulo se sale de la página o pisa algo ya marcado. */
+        bool mark (unsigned x, unsigned y, unsigned rectangle_width, unsigned rectangle_height)
+        {
+            if (x + rectangle_width > width || y + rectangle_height > height) return false;
+
+            for (unsigned row = y; row < y + rectangle_height; ++row)
+            {
+                for (unsigned column = x; column < x + rectangle_width; ++column)
+                {
+                    size_t index = size_t(row) * width + column;
+
+                    if (used[index]) return false;
+
+                    used[index] = true;
+                }
+            }
+
+            return true;
+        }
+
+    };
+
+    // ---------------------------------------------------------------------------------------------
+
+    struct Distribution
+    {
+        const char * name;
+        unsigned     min_width,  max_width;
+        unsigned     min_height, max_height;
+    };
+
+    // Coloca rectángulos aleatorios (ordenados de mayor a menor altura, como hace Atlas_Packer)
+    // hasta que no cabe ninguno más y comprueba que ninguno se solapa ni se sale de la página:
+
+    bool test_skyline (const Distribution & distribution, unsigned seed, float min_occupancy)
+    {
+        const unsigned page_size = 1024;
+
+        mt19937 random(seed);
+
+        uniform_int_distribution< unsigned > random_width (distribution.min_width,  distribution.max_width );
+        uniform_int_distribution< unsigned > random_height(distribution.min_height, distribution.max_height);
+
+        vector< pair< unsigned, unsigned > > rectangles(2000);
+
+        for (auto & rectangle : rectangles) rectangle = { random_width (random), random_height (random) };
+
+        stable_sort
+        (
+            rectangles.begin (), rectangles.end (),
+            [] (const pair< unsigned, unsigned > & a, const pair< unsigned, unsigned > & b)
+            {
+                return a.second != b.second ? a.second > b.second : a.first > b.first;
+            }
+        );
+
+        Skyline_Packer packer(page_size, page_size);
+        Coverage       coverage(page_size, page_size);
+        unsigned       placed = 0;
+
+        for (const auto & rectangle : rectangles)
+        {
+            unsigned x, y;
+
+            if (!packer.insert (rectangle.first, rectangle.second, x, y)) continue;
+
+            if (!coverage.mark (x, y, rectangle.first, rectangle.second))
+            {
+                fprintf
+                (
+                    stderr, "%s (seed %u): %ux%u at %u,%u overlaps or leaves the page\n",
+                    distribution.name, seed, rectangle.first, rectangle.second, x, y
+                );
+                return false;
+            }
+
+            ++placed;
+        }
+
+        float occupancy = packer.get_occupancy ();
+
+        printf
+        (
+            "skyline %-8s seed %2u: %4u rectangles placed, %4u px high, %5.1f%% occupied\n",
+            distribution.name, seed, placed, packer.get_used_height (), occupancy * 100.f
+        );
+
+        if (occupancy < min_occupancy)
+        {
+            fprintf (stderr, "%s (seed %u): occupancy below %.0f%%\n", distribution.name, seed, min_occupancy * 100.f);
+            return false;
+        }
+
+        return true;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    struct Source
+    {
+        Id                       id;
+        Color_Buffer< Rgba8888 > image;
+    };
+
+    // Comprueba que cada imagen tiene su slice, que los slices (con su borde) no se solapan ni se
+    // salen de su página y que los píxeles de la página son los de la imagen:
+
+    bool check_packer (const Atlas_Packer & packer, const vector< Source > & sources, unsigned border)
+    {
+        map< const Atlas *, Coverage > coverages;
+        uint64_t                       used_area = 0;
+        uint64_t                       page_area = 0;
+
+        for (size_t index = 0; index < packer.get_page_count (); ++index)
+        {
+            const Atlas             & page    = packer.get_page (index);
+            const Memory_Texture_2D * texture = dynamic_cast< const Memory_Texture_2D * >(page.get_texture ().get ());
+
+            if (!texture)
+            {
+                fprintf (stderr, "page %u: not a Memory_Texture_2D\n", unsigned(index));
+                return false;
+            }
+
+            const Color_Buffer< Rgba8888 > & pixels = texture->get_color_buffer ();
+
+            coverages[&page] = Coverage(pixels.width, pixels.height);
+            page_area       += uint64_t(pixels.width) * pixels.height;
+
+            printf ("page %u: %ux%u\n", unsigned(index), pixels.width, pixels.height);
+        }
+
+        for (const Source & source : sources)
+        {
+            const Atlas::Slice * slice = packer.get_slice (source.id);
+
+            if (!slice || coverages.count (slice->atlas) == 0)
+            {
+                fprintf (stderr, "image %u: no slice\n", unsigned(source.id));
+                return false;
+            }
+
+            unsigned x      = unsigned(slice->left  );
+            unsigned y      = unsigned(slice->bottom);
+            unsigned width  = source.image.width;
+            unsigned height = source.image.height;
+
+            if (unsigned(slice->width) != width || unsigned(slice->height) != height || x < border || y < border)
+            {
+                fprintf (stderr, "image %u: the slice does not match the image\n", unsigned(source.id));
+                return false;
+            }
+
+            if (!coverages[slice->atlas].mark (x - border, y - border, width + border * 2, height + border * 2))
+            {
+                fprintf (stderr, "image %u: overlaps another image or leaves the page\n", unsigned(source.id));
+                return false;
+            }
+
+            const Memory_Texture_2D        * texture = static_cast< const Memory_Texture_2D * >(slice->atlas->get_texture ().get ());
+            const Color_Buffer< Rgba8888 > & page    = texture->get_color_buffer ();
+
+            Color_Buffer< Rgba8888 > expected = source.image;
+
+            if (texture->is_premultiplied ()) premultiply_alpha (expected);
+
+            for (unsigned row = 0; row < height; ++row)
+            {
+                if (!equal (&expected.buffer[row * width], &expected.buffer[row * width] + width, &page.buffer[size_t(y + row) * page.width + x]))
+                {
+                    fprintf (stderr, "image %u: row %u was not copied to the page\n", unsigned(source.id), row);
+                    return false;
+                }
+            }
+
+            used_area += uint64_t(width) * height;
+        }
+
+        printf
+        (
+            "%u images in %u pages, %.1f%% of the page area used by images\n",
+            unsigned(sources.size ()), unsigned(packer.get_page_count ()),
+            page_area > 0 ? double(used_area) * 100.0 / double(page_area) : 0.0
+        );
+
+        return true;
+    }
+
+    // Empaqueta imágenes generadas con tamaños aleatorios y un contenido distinto en cada una:
+
+    bool test_generated_images (Graphics_Context::Accessor & context)
+    {
+        const unsigned border = 1;
+
+        mt19937                              random(7);
+        uniform_int_distribution< unsigned > random_size (4, 96);
+        uniform_int_distribution< unsigned > random_pixel;
+
+        Atlas_Packer     packer({ 512, 512 }, border);
+        vector< Source > sources(300);
+
+        for (size_t index = 0; index < sources.size (); ++index)
+        {
+            Source & source = sources[index];
+
+            source.id = Id(index + 1);
+            source.image.resize (random_size (random), random_size (random));
+
+            for (Rgba8888 & pixel : source.image.buffer) pixel = random_pixel (random);
+
+            packer.add (source.id, source.image);
+        }
+
+        if (!packer.pack (context))
+        {
+            fprintf (stderr, "the generated images could not be packed\n");
+            return false;
+        }
+
+        return check_packer (packer, sources, border);
+    }
+
+    // Empaqueta imágenes de assets (rutas relativas al directorio de trabajo):
+
+    bool test_asset_images (Graphics_Context::Accessor & context, int number_of_paths, char * paths[])
+    {
+        const unsigned border = 1;
+
+        Atlas_Packer     packer({ 1024, 1024 }, border);
+        vector< Source > sources;
+
+        for (int index = 0; index < number_of_paths; ++index)
+        {
+            Texture_2D::Options          options;
+            Texture_2D::Compressed_Image compressed_image;
+            Source                       source;
+
+            source.id = Id(index + 1);
+
+            if
+            (
+                !Texture_2D::load (paths[index], source.image, compressed_image, options) ||
+                (!compressed_image.data.empty () && !Texture_2D::decompress (compressed_image, source.image))
+            )
+            {
+                fprintf (stderr, "%s: could not be loaded\n", paths[index]);
+                return false;
+            }
+
+            packer.add (source.id, paths[index]);
+
+            sources.push_back (std::move (source));
+        }
+
+        if (!packer.pack (context))
+        {
+            fprintf (stderr, "the images could not be packed\n");
+            return false;
+        }
+
+        return check_packer (packer, sources, border);
+    }
+
+}
+
+int main (int number_of_arguments, char * arguments[])
+{
+    enable< Headless_Context > ();
+
+    Headless_Window                window(ID(atlas_packer_test), { 1024, 1024 });
+    mutex                          context_mutex;
+    shared_ptr< Graphics_Context > context = make_shared< Headless_Context > (window, nullptr, ID(recording));
+    weak_ptr  < Graphics_Context > context_observer = context;
+    Graphics_Context::Accessor     context_accessor(context_observer, context_mutex);
+
+    bool success = true;
+
+    if (number_of_arguments > 1)
+    {
+        success = test_asset_images (context_accessor, number_of_arguments - 1, arguments + 1);
+    }
+    else
+    {
+        const Distribution distributions[] =
+        {
+            { "small",     8,  64,   8,  64 },
+            { "mixed",     4, 256,   4, 256 },
+            { "wide",     64, 512,   4,  48 },
+            { "tall",      4,  48,  64, 512 },
+        };
+
+        for (const Distribution & distribution : distributions)
+        {
+            for (unsigned seed = 1; seed <= 5; ++seed)
+            {
+                success &= test_skyline (distribution, seed, 0.75f);
+            }
+        }
+
+        success &= test_generated_images (context_accessor);
+    }
+
+    return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
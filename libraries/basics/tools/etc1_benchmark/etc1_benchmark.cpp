@@ -0,0 +1,203 @@
+/*
+ * ETC1 BENCHMARK
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610181340
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+#include <basics/etc1>
+#include <basics/png_decode>
+
+using namespace basics;
+using namespace std;
+
+namespace
+{
+
+    typedef chrono::steady_clock Clock;
+
+    bool read_file (const string & path, vector< byte > & data)
+    {
+        ifstream file(path, ios::binary);
+
+        data.assign (istreambuf_iterator< char >(file), istreambuf_iterator< char >());
+
+        return file.good () || file.eof ();
+    }
+
+    // Ejecuta function las veces indicadas y retorna el menor tiempo en milisegundos (o un valor
+    // negativo si alguna ejecución falla):
+
+    template< typename FUNCTION >
+    double fastest_time (unsigned iterations, FUNCTION function)
+    {
+        double fastest = 0.0;
+
+        for (unsigned iteration = 0; iteration < iterations; ++iteration)
+        {
+            Clock::time_point start = Clock::now ();
+
+            if (!function ()) return -1.0;
+
+            double time = chrono::duration< double, milli >(Clock::now () - start).count ();
+
+            if (iteration == 0 || time < fastest) fastest = time;
+        }
+
+        return fastest;
+    }
+
+    // Relación señal/ruido de los canales de color de una imagen comprimida respecto a la original:
+
+    double psnr (const Color_Buffer< Rgba8888 > & original, const Color_Buffer< Rgba8888 > & decoded)
+    {
+        const byte * a = reinterpret_cast< const byte * >(original.buffer.data ());
+        const byte * b = reinterpret_cast< const byte * >(decoded .buffer.data ());
+        double       error = 0.0;
+
+        for (size_t index = 0, end = size_t(original.size ()) * 4; index < end; ++index)
+        {
+            if ((index & 3) == 3) continue;
+
+            double difference = double(a[index]) - double(b[index]);
+
+            error += difference * difference;
+        }
+
+        error /= double(original.size ()) * 3.0;
+
+        return error > 0.0 ? 10.0 * log10 (255.0 * 255.0 / error) : INFINITY;
+    }
+
+    bool all_opaque (const Color_Buffer< Rgba8888 > & color_buffer)
+    {
+        const byte * pixels = reinterpret_cast< const byte * >(color_buffer.buffer.data ());
+
+        for (size_t index = 3, end = size_t(color_buffer.size ()) * 4; index < end; index += 4)
+        {
+            if (pixels[index] != 255) return false;
+        }
+
+        return true;
+    }
+
+    bool benchmark (const string & path, unsigned iterations, double min_psnr)
+    {
+        vector< byte >           png_data;
+        Color_Buffer< Rgba8888 > original;
+        unsigned                 width, height;
+        bool                     opaque;
+
+        if (!read_file (path, png_data) || !png_decode (png_data, original, width, height, opaque))
+        {
+            fprintf (stderr, "%s: could not be decoded\n", path.c_str ());
+            return false;
+        }
+
+        // ETC1 no guarda alfa, por lo que raw_texture_converter no comprime las imágenes con
+        // transparencia:
+
+        if (!opaque)
+        {
+            printf ("%-40s %5ux%-5u  skipped (has transparency)\n", path.c_str (), width, height);
+            return true;
+        }
+
+        vector< byte >           blocks;
+        Color_Buffer< Rgba8888 > decoded;
+
+        double encode_time = fastest_time (iterations, [&] () { etc1_encode (original, blocks); return true; });
+        double decode_time = fastest_time
+        (
+            iterations, [&] () { return etc1_decode (blocks.data (), blocks.size (), width, height, decoded); }
+        );
+
+        if
+        (
+            blocks.size () != etc1_data_size (width, height) || decode_time < 0.0 ||
+            decoded.width  != width || decoded.height != height || !all_opaque (decoded)
+        )
+        {
+            fprintf (stderr, "%s: round trip failed\n", path.c_str ());
+            return false;
+        }
+
+        // Si faltan datos no se debe descomprimir:
+
+        Color_Buffer< Rgba8888 > truncated;
+
+        if (etc1_decode (blocks.data (), blocks.size () - 1, width, height, truncated))
+        {
+            fprintf (stderr, "%s: truncated ETC1 data was accepted\n", path.c_str ());
+            return false;
+        }
+
+        double quality = psnr (original, decoded);
+
+        printf
+        (
+            "%-40s %5ux%-5u  rgba %8u B  etc1 %7u B  encode %9.3f ms  decode %7.3f ms  %5.1f dB\n",
+            path.c_str (), width, height,
+            unsigned(size_t(original.size ()) * 4), unsigned(blocks.size ()),
+            encode_time, decode_time, quality
+        );
+
+        if (quality < min_psnr)
+        {
+            fprintf (stderr, "%s: PSNR below %.1f dB\n", path.c_str (), min_psnr);
+            return false;
+        }
+
+        return true;
+    }
+
+}
+
+int main (int number_of_arguments, char * arguments[])
+{
+    unsigned iterations = 5;
+    double   min_psnr   = 30.0;
+    unsigned failures   = 0;
+    unsigned images     = 0;
+
+    for (int index = 1; index < number_of_arguments; ++index)
+    {
+        if (strcmp (arguments[index], "--iterations") == 0 && index + 1 < number_of_arguments)
+        {
+            iterations = max (1, atoi (arguments[++index]));
+        }
+        else if (strcmp (arguments[index], "--min-psnr") == 0 && index + 1 < number_of_arguments)
+        {
+            min_psnr = atof (arguments[++index]);
+        }
+        else
+        {
+            if (!benchmark (arguments[index], iterations, min_psnr)) ++failures;
+
+            ++images;
+        }
+    }
+
+    if (images == 0)
+    {
+        fprintf (stderr, "usage: etc1_benchmark [--iterations n] [--min-psnr db] image.png [...]\n");
+        return EXIT_FAILURE;
+    }
+
+    return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
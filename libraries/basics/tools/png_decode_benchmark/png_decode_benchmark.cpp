@@ -0,0 +1,168 @@
+/*
+ * PNG DECODE BENCHMARK
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610181300
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+#include <basics/png_decode>
+#include "lodepng.h"
+
+using namespace basics;
+using namespace std;
+
+namespace
+{
+
+    typedef chrono::steady_clock Clock;
+
+    bool read_file (const string & path, vector< byte > & data)
+    {
+        ifstream file(path, ios::binary);
+
+        data.assign (istreambuf_iterator< char >(file), istreambuf_iterator< char >());
+
+        return file.good () || file.eof ();
+    }
+
+    // Vuelve a codificar los píxeles con cada tipo de bloque de deflate y con los cinco filtros de
+    // PNG alternándose por filas, en RGBA y (si la imagen es opaca) en RGB, y comprueba que al
+    // decodificar el resultado se obtienen los mismos píxeles:
+
+    bool check_round_trip (const string & path, const Color_Buffer< Rgba8888 > & pixels, unsigned width, unsigned height, bool opaque)
+    {
+        const unsigned char   * data = reinterpret_cast< const unsigned char * >(pixels.buffer.data ());
+        vector< unsigned char > filters(height);
+
+        for (unsigned row = 0; row < height; ++row) filters[row] = (unsigned char)(row % 5);
+
+        const LodePNGColorType color_types[] = { LCT_RGBA, LCT_RGB };
+
+        for (unsigned block_type = 0; block_type < 3; ++block_type)
+        {
+            for (LodePNGColorType color_type : color_types)
+            {
+                if (color_type == LCT_RGB && !opaque) continue;
+
+                lodepng::State state;
+
+                state.encoder.auto_convert        = 0;
+                state.encoder.filter_palette_zero = 0;
+                state.encoder.filter_strategy     = LFS_PREDEFINED;
+                state.encoder.predefined_filters  = filters.data ();
+                state.encoder.zlibsettings.btype  = block_type;
+                state.info_png.color.colortype    = color_type;
+                state.info_png.color.bitdepth     = 8;
+
+                vector< unsigned char >  encoded;
+                Color_Buffer< Rgba8888 > decoded;
+                unsigned                 decoded_width, decoded_height;
+
+                if
+                (
+                    lodepng::encode (encoded, data, width, height, state) != 0 ||
+                    !png_decode (encoded, decoded, decoded_width, decoded_height) ||
+                    decoded_width != width || decoded_height != height ||
+                    decoded.buffer != pixels.buffer
+                )
+                {
+                    fprintf
+                    (
+                        stderr, "%s: round trip failed (block type %u, %s)\n",
+                        path.c_str (), block_type, color_type == LCT_RGB ? "RGB" : "RGBA"
+                    );
+
+                    return false;
+                }
+            }
+        }
+
+        return true;
+    }
+
+    bool benchmark (const string & path, unsigned iterations)
+    {
+        vector< byte > png_data;
+
+        if (!read_file (path, png_data))
+        {
+            fprintf (stderr, "%s: could not be read\n", path.c_str ());
+            return false;
+        }
+
+        Color_Buffer< Rgba8888 > pixels;
+        unsigned                 width, height;
+        bool                     opaque = false;
+        vector< double >         times;
+
+        for (unsigned iteration = 0; iteration < iterations; ++iteration)
+        {
+            Clock::time_point start = Clock::now ();
+
+            if (!png_decode (png_data, pixels, width, height, opaque))
+            {
+                fprintf (stderr, "%s: could not be decoded\n", path.c_str ());
+                return false;
+            }
+
+            times.push_back (chrono::duration< double, milli >(Clock::now () - start).count ());
+        }
+
+        sort (times.begin (), times.end ());
+
+        double median    = times[times.size () / 2];
+        double megabytes = double(width) * height * 4.0 / (1024.0 * 1024.0);
+
+        printf
+        (
+            "%-40s %5ux%-5u  min %8.3f ms  median %8.3f ms  %7.1f MB/s\n",
+            path.c_str (), width, height, times.front (), median, megabytes / (median / 1000.0)
+        );
+
+        return check_round_trip (path, pixels, width, height, opaque);
+    }
+
+}
+
+int main (int number_of_arguments, char * arguments[])
+{
+    unsigned iterations = 20;
+    unsigned failures   = 0;
+    unsigned images     = 0;
+
+    for (int index = 1; index < number_of_arguments; ++index)
+    {
+        if (strcmp (arguments[index], "--iterations") == 0 && index + 1 < number_of_arguments)
+        {
+            iterations = max (1, atoi (arguments[++index]));
+        }
+        else
+        {
+            if (!benchmark (arguments[index], iterations)) ++failures;
+
+            ++images;
+        }
+    }
+
+    if (images == 0)
+    {
+        fprintf (stderr, "usage: png_decode_benchmark [--iterations n] image.png [...]\n");
+        return EXIT_FAILURE;
+    }
+
+    return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
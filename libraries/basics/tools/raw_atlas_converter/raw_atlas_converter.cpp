@@ -0,0 +1,183 @@
+/*
+ * RAW ATLAS CONVERTER
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610181010
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <rapidxml.hpp>
+#include <basics/fnv>
+#include <basics/raw_atlas>
+
+using namespace basics;
+using namespace rapidxml;
+using namespace std;
+
+namespace
+{
+
+    bool read_file (const string & path, vector< char > & data)
+    {
+        ifstream file(path, ios::binary);
+
+        data.assign (istreambuf_iterator< char >(file), istreambuf_iterator< char >());
+
+        return file.good () || file.eof ();
+    }
+
+    bool write_file (const string & path, const vector< byte > & data)
+    {
+        ofstream file(path, ios::binary | ios::trunc);
+
+        file.write (reinterpret_cast< const char * >(data.data ()), streamsize(data.size ()));
+
+        return file.good ();
+    }
+
+    // Recorre los "dir" y "spr" formando los nombres de los slices igual que Atlas::parse_dir():
+
+    bool parse_dir (xml_node<> * dir_tag, const string & prefix, vector< Raw_Atlas_Slice > & slices, const string & path)
+    {
+        for (xml_node<> * child = dir_tag->first_node (); child; child = child->next_sibling ())
+        {
+            if (child->type () != node_element) continue;
+
+            xml_attribute<> * name_attribute = child->first_attribute ("name");
+
+            if (!name_attribute) continue;
+
+            string id = prefix + name_attribute->value ();
+
+            if (child->name () == string("dir"))
+            {
+                if (id == "/") id.clear (); else id += ".";
+
+                if (!parse_dir (child, id, slices, path)) return false;
+            }
+            else
+            if (child->name () == string("spr"))
+            {
+                xml_attribute<> * x_attribute = child->first_attribute ("x");
+                xml_attribute<> * y_attribute = child->first_attribute ("y");
+                xml_attribute<> * w_attribute = child->first_attribute ("w");
+                xml_attribute<> * h_attribute = child->first_attribute ("h");
+
+                if (!x_attribute || !y_attribute || !w_attribute || !h_attribute)
+                {
+                    fprintf (stderr, "%s: sprite %s is incomplete\n", path.c_str (), id.c_str ());
+                    return false;
+                }
+
+                Raw_Atlas_Slice slice;
+
+                slice.id     = fnv32 (id);
+                slice.x      = uint16_t(atoi (x_attribute->value ()));
+                slice.y      = uint16_t(atoi (y_attribute->value ()));
+                slice.width  = uint16_t(atoi (w_attribute->value ()));
+                slice.height = uint16_t(atoi (h_attribute->value ()));
+
+                slices.push_back (slice);
+            }
+        }
+
+        return true;
+    }
+
+    // Convierte un .sprites y comprueba que al leer el resultado se obtienen los mismos slices:
+
+    bool convert (const string & sprites_path)
+    {
+        vector< char > text;
+
+        if (!read_file (sprites_path, text) || text.empty ())
+        {
+            fprintf (stderr, "%s: could not be read\n", sprites_path.c_str ());
+            return false;
+        }
+
+        // El hash se calcula antes de añadir el nulo para que coincida con el del archivo:
+
+        uint32_t source_hash = fnv32 (reinterpret_cast< const byte * >(text.data ()), text.size ());
+
+        text.push_back (0);
+
+        xml_document<> xml;
+
+        xml.parse< 0 > (text.data ());
+
+        xml_node<>      * img_tag         = xml.first_node ("img");
+        xml_attribute<> * name_attribute  = img_tag ? img_tag->first_attribute ("name") : nullptr;
+        xml_node<>      * definitions_tag = img_tag ? img_tag->first_node ("definitions") : nullptr;
+
+        if (!name_attribute || !definitions_tag)
+        {
+            fprintf (stderr, "%s: is not a valid atlas\n", sprites_path.c_str ());
+            return false;
+        }
+
+        vector< Raw_Atlas_Slice > slices;
+
+        for (xml_node<> * dir_tag = definitions_tag->first_node ("dir"); dir_tag; dir_tag = dir_tag->next_sibling ("dir"))
+        {
+            if (!parse_dir (dir_tag, string(), slices, sprites_path)) return false;
+        }
+
+        vector< byte > raw_data;
+
+        if (!raw_atlas_encode (name_attribute->value (), source_hash, slices, raw_data))
+        {
+            fprintf (stderr, "%s: two sprites have the same id\n", sprites_path.c_str ());
+            return false;
+        }
+
+        const Raw_Atlas_Header * header = raw_atlas_header (raw_data);
+
+        if (!header || header->slice_count != slices.size () || raw_atlas_texture_name (header) != name_attribute->value ())
+        {
+            fprintf (stderr, "%s: round trip failed\n", sprites_path.c_str ());
+            return false;
+        }
+
+        size_t dot      = sprites_path.find_last_of ('.');
+        string raw_path = sprites_path.substr (0, dot == string::npos ? sprites_path.size () : dot) + raw_atlas_extension;
+
+        if (!write_file (raw_path, raw_data))
+        {
+            fprintf (stderr, "%s: could not be written\n", raw_path.c_str ());
+            return false;
+        }
+
+        printf ("%s -> %s (%u slices, %s)\n", sprites_path.c_str (), raw_path.c_str (), unsigned(slices.size ()), name_attribute->value ());
+
+        return true;
+    }
+
+}
+
+int main (int number_of_arguments, char * arguments[])
+{
+    bool success = true;
+
+    for (int index = 1; index < number_of_arguments; ++index)
+    {
+        success &= convert (arguments[index]);
+    }
+
+    if (number_of_arguments < 2)
+    {
+        fprintf (stderr, "usage: raw_atlas_converter atlas.sprites [...]\n");
+        return 2;
+    }
+
+    return success ? 0 : 1;
+}
@@ -0,0 +1,176 @@
+/*
+ * RAW FONT CONVERTER
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610181020
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <rapidxml.hpp>
+#include <basics/fnv>
+#include <basics/raw_font>
+
+using namespace basics;
+using namespace rapidxml;
+using namespace std;
+
+namespace
+{
+
+    bool read_file (const string & path, vector< char > & data)
+    {
+        ifstream file(path, ios::binary);
+
+        data.assign (istreambuf_iterator< char >(file), istreambuf_iterator< char >());
+
+        return file.good () || file.eof ();
+    }
+
+    bool write_file (const string & path, const vector< byte > & data)
+    {
+        ofstream file(path, ios::binary | ios::trunc);
+
+        file.write (reinterpret_cast< const char * >(data.data ()), streamsize(data.size ()));
+
+        return file.good ();
+    }
+
+    int attribute_of (xml_node<> * tag, const char * name, bool & found)
+    {
+        xml_attribute<> * attribute = tag ? tag->first_attribute (name) : nullptr;
+
+        if (!attribute) found = false;
+
+        return attribute ? atoi (attribute->value ()) : 0;
+    }
+
+    // Convierte un .fnt y comprueba que al leer el resultado se obtienen los mismos datos. Se
+    // rechazan las fuentes que Raster_Font tampoco aceptaría al leer el XML:
+
+    bool convert (const string & font_path)
+    {
+        vector< char > text;
+
+        if (!read_file (font_path, text) || text.empty ())
+        {
+            fprintf (stderr, "%s: could not be read\n", font_path.c_str ());
+            return false;
+        }
+
+        // El hash se calcula antes de añadir el nulo para que coincida con el del archivo:
+
+        uint32_t source_hash = fnv32 (reinterpret_cast< const byte * >(text.data ()), text.size ());
+
+        text.push_back (0);
+
+        xml_document<> xml;
+
+        xml.parse< 0 > (text.data ());
+
+        xml_node<>      * font_tag       = xml.first_node ("font");
+        xml_node<>      * info_tag       = font_tag  ? font_tag ->first_node ("info"  ) : nullptr;
+        xml_node<>      * common_tag     = font_tag  ? font_tag ->first_node ("common") : nullptr;
+        xml_node<>      * pages_tag      = font_tag  ? font_tag ->first_node ("pages" ) : nullptr;
+        xml_node<>      * chars_tag      = font_tag  ? font_tag ->first_node ("chars" ) : nullptr;
+        xml_node<>      * page_tag       = pages_tag ? pages_tag->first_node ("page"  ) : nullptr;
+        xml_attribute<> * face_attribute = info_tag  ? info_tag ->first_attribute ("face") : nullptr;
+        xml_attribute<> * file_attribute = page_tag  ? page_tag ->first_attribute ("file") : nullptr;
+
+        bool found       = true;
+        int  line_height = attribute_of (common_tag, "lineHeight", found);
+        int  base        = attribute_of (common_tag, "base",       found);
+        int  page_count  = common_tag && common_tag->first_attribute ("pages") ? atoi (common_tag->first_attribute ("pages")->value ()) : 1;
+
+        if (!face_attribute || !file_attribute || !chars_tag || !found || page_count != 1 || line_height <= 0 || base <= 0)
+        {
+            fprintf (stderr, "%s: is not a valid single page BMFont XML file\n", font_path.c_str ());
+            return false;
+        }
+
+        vector< Raw_Font_Glyph > glyphs;
+
+        for (xml_node<> * char_tag = chars_tag->first_node ("char"); char_tag; char_tag = char_tag->next_sibling ("char"))
+        {
+            Raw_Font_Glyph glyph{};
+
+            glyph.code     = uint32_t(attribute_of (char_tag, "id",       found));
+            glyph.x        = uint16_t(attribute_of (char_tag, "x",        found));
+            glyph.y        = uint16_t(attribute_of (char_tag, "y",        found));
+            glyph.width    = uint16_t(attribute_of (char_tag, "width",    found));
+            glyph.height   = uint16_t(attribute_of (char_tag, "height",   found));
+            glyph.x_offset =  int16_t(attribute_of (char_tag, "xoffset",  found));
+            glyph.y_offset =  int16_t(attribute_of (char_tag, "yoffset",  found));
+            glyph.advance  =  int16_t(attribute_of (char_tag, "xadvance", found));
+
+            if (!found || glyph.width == 0 || glyph.height == 0)
+            {
+                fprintf (stderr, "%s: character %u is not valid\n", font_path.c_str (), glyph.code);
+                return false;
+            }
+
+            glyphs.push_back (glyph);
+        }
+
+        vector< byte > raw_data;
+
+        if (glyphs.empty () || !raw_font_encode (face_attribute->value (), file_attribute->value (), unsigned(line_height), unsigned(base), source_hash, glyphs, raw_data))
+        {
+            fprintf (stderr, "%s: has no characters or has repeated ones\n", font_path.c_str ());
+            return false;
+        }
+
+        const Raw_Font_Header * header = raw_font_header (raw_data);
+
+        if
+        (
+            !header || header->glyph_count != glyphs.size () ||
+            raw_font_face         (header) != face_attribute->value () ||
+            raw_font_texture_name (header) != file_attribute->value ()
+        )
+        {
+            fprintf (stderr, "%s: round trip failed\n", font_path.c_str ());
+            return false;
+        }
+
+        size_t dot      = font_path.find_last_of ('.');
+        string raw_path = font_path.substr (0, dot == string::npos ? font_path.size () : dot) + raw_font_extension;
+
+        if (!write_file (raw_path, raw_data))
+        {
+            fprintf (stderr, "%s: could not be written\n", raw_path.c_str ());
+            return false;
+        }
+
+        printf ("%s -> %s (%u characters, %s)\n", font_path.c_str (), raw_path.c_str (), unsigned(glyphs.size ()), file_attribute->value ());
+
+        return true;
+    }
+
+}
+
+int main (int number_of_arguments, char * arguments[])
+{
+    bool success = true;
+
+    for (int index = 1; index < number_of_arguments; ++index)
+    {
+        success &= convert (arguments[index]);
+    }
+
+    if (number_of_arguments < 2)
+    {
+        fprintf (stderr, "usage: raw_font_converter font.fnt [...]\n");
+        return 2;
+    }
+
+    return success ? 0 : 1;
+}
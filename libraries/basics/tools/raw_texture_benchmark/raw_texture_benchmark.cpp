@@ -0,0 +1,169 @@
+/*
+ * RAW TEXTURE BENCHMARK
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610181320
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+#include <basics/png_decode>
+#include <basics/raw_texture>
+
+using namespace basics;
+using namespace std;
+
+namespace
+{
+
+    typedef chrono::steady_clock Clock;
+
+    bool read_file (const string & path, vector< byte > & data)
+    {
+        ifstream file(path, ios::binary);
+
+        data.assign (istreambuf_iterator< char >(file), istreambuf_iterator< char >());
+
+        return file.good () || file.eof ();
+    }
+
+    // Ejecuta function las veces indicadas y retorna el menor tiempo en milisegundos (o un valor
+    // negativo si alguna ejecución falla):
+
+    template< typename FUNCTION >
+    double fastest_time (unsigned iterations, FUNCTION function)
+    {
+        double fastest = 0.0;
+
+        for (unsigned iteration = 0; iteration < iterations; ++iteration)
+        {
+            Clock::time_point start = Clock::now ();
+
+            if (!function ()) return -1.0;
+
+            double time = chrono::duration< double, milli >(Clock::now () - start).count ();
+
+            if (iteration == 0 || time < fastest) fastest = time;
+        }
+
+        return fastest;
+    }
+
+    bool benchmark (const string & path, unsigned iterations)
+    {
+        vector< byte > png_data;
+
+        if (!read_file (path, png_data))
+        {
+            fprintf (stderr, "%s: could not be read\n", path.c_str ());
+            return false;
+        }
+
+        Color_Buffer< Rgba8888 > png_pixels;
+        unsigned                 width, height;
+        bool                     opaque;
+
+        double png_time = fastest_time
+        (
+            iterations, [&] () { return png_decode (png_data, png_pixels, width, height, opaque); }
+        );
+
+        if (png_time < 0.0)
+        {
+            fprintf (stderr, "%s: could not be decoded\n", path.c_str ());
+            return false;
+        }
+
+        // Se guarda la versión en bruto en memoria (marcada como premultiplicada para comprobar que
+        // el indicador se conserva, aunque los píxeles no lo estén):
+
+        vector< byte > raw_data;
+
+        raw_texture_encode (png_pixels, opaque, true, raw_data);
+
+        Color_Buffer< Rgba8888 > raw_pixels;
+        unsigned                 raw_width, raw_height;
+        bool                     raw_opaque, raw_premultiplied;
+
+        double raw_time = fastest_time
+        (
+            iterations, [&] ()
+            {
+                return raw_texture_decode (raw_data, raw_pixels, raw_width, raw_height, raw_opaque, raw_premultiplied);
+            }
+        );
+
+        if
+        (
+            raw_time < 0.0 || raw_width != width || raw_height != height || raw_opaque != opaque ||
+            !raw_premultiplied || raw_pixels.buffer != png_pixels.buffer
+        )
+        {
+            fprintf (stderr, "%s: round trip failed\n", path.c_str ());
+            return false;
+        }
+
+        // Un archivo truncado se debe rechazar:
+
+        vector< byte > truncated(raw_data.begin (), raw_data.end () - 1);
+
+        if (raw_texture_header (truncated) != nullptr)
+        {
+            fprintf (stderr, "%s: a truncated raw texture was accepted\n", path.c_str ());
+            return false;
+        }
+
+        printf
+        (
+            "%-40s %5ux%-5u  png %8u B %8.3f ms  btex %8u B %8.3f ms  x%.1f\n",
+            path.c_str (), width, height,
+            unsigned(png_data.size ()), png_time,
+            unsigned(raw_data.size ()), raw_time,
+            raw_time > 0.0 ? png_time / raw_time : 0.0
+        );
+
+        return true;
+    }
+
+}
+
+int main (int number_of_arguments, char * arguments[])
+{
+    unsigned iterations = 20;
+    unsigned failures   = 0;
+    unsigned images     = 0;
+
+    for (int index = 1; index < number_of_arguments; ++index)
+    {
+        if (strcmp (arguments[index], "--iterations") == 0 && index + 1 < number_of_arguments)
+        {
+            iterations = max (1, atoi (arguments[++index]));
+        }
+        else
+        {
+            if (!benchmark (arguments[index], iterations)) ++failures;
+
+            ++images;
+        }
+    }
+
+    if (images == 0)
+    {
+        fprintf (stderr, "usage: raw_texture_benchmark [--iterations n] image.png [...]\n");
+        return EXIT_FAILURE;
+    }
+
+    return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,193 @@
+/*
+ * RAW TEXTURE CONVERTER
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610172130
+ */
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <basics/etc1>
+#include <basics/png_decode>
+#include <basics/raw_texture>
+
+using namespace basics;
+using namespace std;
+
+namespace
+{
+
+    bool read_file (const string & path, vector< byte > & data)
+    {
+        ifstream file(path, ios::binary);
+
+        data.assign (istreambuf_iterator< char >(file), istreambuf_iterator< char >());
+
+        return file.good () || file.eof ();
+    }
+
+    bool write_file (const string & path, const vector< byte > & data)
+    {
+        ofstream file(path, ios::binary | ios::trunc);
+
+        file.write (reinterpret_cast< const char * >(data.data ()), streamsize(data.size ()));
+
+        return file.good ();
+    }
+
+    void premultiply (Color_Buffer< Rgba8888 > & color_buffer)
+    {
+        byte * pixel = color_buffer;
+        byte * end   = pixel + size_t(color_buffer.size ()) * sizeof(Rgba8888);
+
+        for ( ; pixel < end; pixel += 4)
+        {
+            unsigned alpha = pixel[3];
+
+            pixel[0] = byte((pixel[0] * alpha + 127) / 255);
+            pixel[1] = byte((pixel[1] * alpha + 127) / 255);
+            pixel[2] = byte((pixel[2] * alpha + 127) / 255);
+        }
+    }
+
+    // Relación señal/ruido de los canales de color de una imagen comprimida respecto a la original:
+
+    double psnr (const Color_Buffer< Rgba8888 > & original, const Color_Buffer< Rgba8888 > & decoded)
+    {
+        const byte * a = reinterpret_cast< const byte * >(original.buffer.data ());
+        const byte * b = reinterpret_cast< const byte * >(decoded .buffer.data ());
+        double       error = 0.0;
+
+        for (size_t index = 0, end = size_t(original.size ()) * 4; index < end; ++index)
+        {
+            if ((index & 3) == 3) continue;
+
+            double difference = double(a[index]) - double(b[index]);
+
+            error += difference * difference;
+        }
+
+        error /= double(original.size ()) * 3.0;
+
+        return error > 0.0 ? 10.0 * log10 (255.0 * 255.0 / error) : INFINITY;
+    }
+
+    // Convierte un PNG y comprueba que al cargar el resultado se obtienen los mismos píxeles (o,
+    // si se comprime, que la calidad es aceptable):
+
+    bool convert (const string & png_path, bool premultiplied, bool etc1)
+    {
+        vector< byte >           png_data;
+        Color_Buffer< Rgba8888 > color_buffer;
+        unsigned                 width, height;
+        bool                     opaque;
+
+        if (!read_file (png_path, png_data) || !png_decode (png_data, color_buffer, width, height, opaque))
+        {
+            fprintf (stderr, "%s: could not be decoded\n", png_path.c_str ());
+            return false;
+        }
+
+        if (premultiplied && !opaque) premultiply (color_buffer); else premultiplied = false;
+
+        vector< byte > raw_data;
+
+        // ETC1 no guarda alfa, por lo que solo se comprimen las imágenes opacas:
+
+        if (etc1 && !opaque)
+        {
+            printf ("%s: has transparency, it is kept uncompressed\n", png_path.c_str ());
+
+            etc1 = false;
+        }
+
+        if (etc1)
+        {
+            vector< byte > blocks;
+
+            etc1_encode (color_buffer, blocks);
+
+            raw_texture_encode (Raw_Texture_Header::ETC1_RGB8, width, height, opaque, false, blocks, raw_data);
+        }
+        else
+        {
+            raw_texture_encode (color_buffer, opaque, premultiplied, raw_data);
+        }
+
+        Color_Buffer< Rgba8888 > decoded;
+        unsigned                 decoded_width, decoded_height;
+        bool                     decoded_opaque, decoded_premultiplied;
+
+        if
+        (
+            !raw_texture_decode (raw_data, decoded, decoded_width, decoded_height, decoded_opaque, decoded_premultiplied) ||
+            decoded_width  != width  || decoded_height        != height || decoded_opaque != opaque ||
+            decoded_premultiplied != premultiplied || (!etc1 && decoded.buffer != color_buffer.buffer)
+        )
+        {
+            fprintf (stderr, "%s: round trip failed\n", png_path.c_str ());
+            return false;
+        }
+
+        size_t dot      = png_path.find_last_of ('.');
+        string raw_path = png_path.substr (0, dot == string::npos ? png_path.size () : dot) + raw_texture_extension;
+
+        if (!write_file (raw_path, raw_data))
+        {
+            fprintf (stderr, "%s: could not be written\n", raw_path.c_str ());
+            return false;
+        }
+
+        printf ("%s -> %s (%ux%u%s%s)", png_path.c_str (), raw_path.c_str (), width, height, opaque ? ", opaque" : "", premultiplied ? ", premultiplied" : "");
+
+        if (etc1) printf (" etc1 %.2f dB", psnr (color_buffer, decoded));
+
+        printf ("\n");
+
+        return true;
+    }
+
+}
+
+int main (int number_of_arguments, char * arguments[])
+{
+    bool premultiplied = false;
+    bool etc1          = false;
+    bool success       = true;
+    int  converted     = 0;
+
+    for (int index = 1; index < number_of_arguments; ++index)
+    {
+        if (strcmp (arguments[index], "--premultiply") == 0)
+        {
+            premultiplied = true;
+        }
+        else
+        if (strcmp (arguments[index], "--etc1") == 0)
+        {
+            etc1 = true;
+        }
+        else
+        {
+            success &= convert (arguments[index], premultiplied, etc1);
+            converted++;
+        }
+    }
+
+    if (converted == 0)
+    {
+        fprintf (stderr, "usage: raw_texture_converter [--premultiply] [--etc1] image.png [...]\n");
+        return 2;
+    }
+
+    return success ? 0 : 1;
+}
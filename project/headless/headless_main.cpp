@@ -0,0 +1,220 @@
+/*
+ * HEADLESS MAIN
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <basics/Application>
+#include <basics/Director>
+#include <basics/enable>
+#include <basics/Headless_Context>
+#include <basics/Recording_Canvas>
+#include <basics/Software_Canvas>
+#include <basics/Window>
+
+#include "Credits_Scene.hpp"
+#include "Game_Scene.hpp"
+#include "Gameover_Scene.hpp"
+#include "Help_Scene.hpp"
+#include "Intro_Scene.hpp"
+#include "Menu_Scene.hpp"
+#include "Pause_Scene.hpp"
+
+using namespace basics;
+using namespace flip;
+using namespace std;
+
+namespace
+{
+
+    unsigned frame_limit  = 240;
+    unsigned scene_frames = 0;
+    Id       backend      = ID(recording);
+
+    // Headless context that presents frames at 60 Hz (so the game timers behave as on a device) and asks the
+    // application to quit once the current scene has presented frame_limit frames:
+
+    class Paced_Context : public Headless_Context
+    {
+
+        chrono::steady_clock::time_point next_frame;
+
+    public:
+
+        Paced_Context(Window & window, Graphics_Resource_Cache * cache)
+        :
+            Headless_Context(window, cache, backend),
+            next_frame      (chrono::steady_clock::now ())
+        {
+        }
+
+        bool flush_and_display () override
+        {
+            bool displayed = Headless_Context::flush_and_display ();
+
+            next_frame += chrono::microseconds(16667);
+
+            this_thread::sleep_until (next_frame);
+
+            if (++scene_frames == frame_limit) application.push (Event(Application::QUIT));
+
+            return displayed;
+        }
+
+        static bool create (Window::Accessor & window, Graphics_Resource_Cache * cache)
+        {
+            return window->set_graphics_context (make_shared< Paced_Context > (*window.operator -> (), cache));
+        }
+
+    };
+
+    // Prints what a scene drew and checks that the recorded commands can be replayed:
+
+    int report (const char * scene_name)
+    {
+        Window::Accessor window = Window::get_window (default_window_id).lock ();
+
+        if (!window)
+        {
+            fprintf (stderr, "the window was not created\n");
+            return 1;
+        }
+
+        Graphics_Context::Accessor context = window->lock_graphics_context ();
+        Paced_Context            * paced   = context ? dynamic_cast< Paced_Context * >(context.operator -> ()) : nullptr;
+        Canvas                   * canvas  = context ? context->get_renderer< Canvas > (ID(canvas)) : nullptr;
+
+        if (!paced || !canvas)
+        {
+            fprintf (stderr, "no frame was rendered\n");
+            return 1;
+        }
+
+        printf ("%s\n", scene_name);
+        printf ("frames presented: %u\n", scene_frames);
+
+        Recording_Canvas * recording = dynamic_cast< Recording_Canvas * >(canvas);
+
+        if (recording)
+        {
+            const Recording_Canvas::Statistics & total = recording->get_statistics ();
+            const Recording_Canvas::Statistics & last  = recording->get_last_frame_statistics ();
+
+            printf ("recorded frames:  %zu\n", total.frames);
+            printf ("draws:            %zu (last frame %zu)\n", total.draws, last.draws);
+            printf ("state changes:    %zu (last frame %zu)\n", total.state_changes, last.state_changes);
+            printf ("command bytes:    %zu (last frame %zu)\n", total.bytes, last.bytes);
+
+            // Texts are replayed glyph by glyph, so the copy gets the same draws but not the same bytes:
+
+            Recording_Canvas copy({ 1, 1 });
+
+            copy.reset_recording ();
+
+            if (!recording->replay (copy) || copy.get_statistics ().draws != total.draws || copy.get_statistics ().frames != total.frames)
+            {
+                fprintf (stderr, "the recorded commands could not be replayed\n");
+                return 1;
+            }
+
+            printf ("replay:           ok\n");
+
+            if (last.draws == 0)
+            {
+                fprintf (stderr, "the last frame did not draw anything\n");
+                return 1;
+            }
+
+            recording->reset_recording ();
+        }
+
+        Software_Canvas * software = dynamic_cast< Software_Canvas * >(canvas);
+
+        if (software)
+        {
+            const Software_Canvas::Statistics & last = software->get_last_frame_statistics ();
+
+            size_t buffer_size = software->get_color_buffer ().size ();
+
+            printf ("draws:            %zu (last frame)\n", last.draws);
+            printf ("pixels written:   %zu (last frame)\n", last.pixels);
+            printf ("overdraw:         %.2f (last frame)\n", last.overdraw (buffer_size));
+
+            if (last.pixels == 0)
+            {
+                fprintf (stderr, "the last frame did not write any pixel\n");
+                return 1;
+            }
+        }
+
+        return 0;
+    }
+
+}
+
+int main (int number_of_arguments, char * arguments[])
+{
+    if (number_of_arguments > 1) frame_limit = unsigned(atoi (arguments[1]));
+
+    if (number_of_arguments > 2 && strcmp (arguments[2], "software") == 0) backend = ID(software);
+
+    if (frame_limit == 0)
+    {
+        fprintf (stderr, "usage: flip_headless [frames] [recording|software]\n");
+        return 2;
+    }
+
+    // The canvas and texture factories of the headless backends replace the OpenGL ES ones:
+    enable< Headless_Context > ();
+
+    director.set_graphics_context_factory (Paced_Context::create);
+
+    // Each scene is run directly for frame_limit frames. The scenes that move on by themselves (as the intro)
+    // are reported under the scene they started from:
+
+    struct Scene_Run
+    {
+        const char           * name;
+        shared_ptr< Scene >    scene;
+    };
+
+    const Scene_Run scene_runs[] =
+    {
+        { "Intro_Scene",    shared_ptr< Scene >(new Intro_Scene            ) },
+        { "Menu_Scene",     shared_ptr< Scene >(new Menu_Scene             ) },
+        { "Help_Scene",     shared_ptr< Scene >(new Help_Scene             ) },
+        { "Credits_Scene",  shared_ptr< Scene >(new Credits_Scene          ) },
+        { "Game_Scene",     shared_ptr< Scene >(new Game_Scene             ) },
+        { "Pause_Scene",    shared_ptr< Scene >(new Pause_Scene            ) },
+        { "Gameover_Scene", shared_ptr< Scene >(new Gameover_Scene(120, 60.f)) },
+    };
+
+    int result = 0;
+
+    for (const Scene_Run & run : scene_runs)
+    {
+        // The director only finds the window through WINDOW_CREATED, which the window sends once, so the runs
+        // after the first one are told again that it exists:
+
+        if (scene_frames > 0) application.push (Event(Application::WINDOW_CREATED));
+
+        scene_frames = 0;
+
+        director.run_scene (run.scene);
+
+        if (report (run.name) != 0) result = 1;
+
+        printf ("\n");
+    }
+
+    return result;
+}